@@ -0,0 +1,216 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_BENCH_HPP_
+#define VIPER25519_BENCH_HPP_
+
+// Standard Library Headers
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define VIPER25519_BENCH_HAS_TSC 1
+#endif
+
+/// Minimal benchmark harness shared by the benchmark executables.
+namespace bench
+{
+
+/// @brief Keep the compiler from optimizing away a computed value.
+template <typename T>
+inline auto doNotOptimize(const T& value) -> void
+{
+    asm volatile("" : : "r"(&value) : "memory");
+}  // doNotOptimize
+
+/// @brief Read the time stamp counter, or zero where there is none.
+/// The counter ticks at a constant reference rate, so cycles per operation
+/// are only comparable between runs with the same CPU frequency settings.
+inline auto cycles() -> uint64_t
+{
+#ifdef VIPER25519_BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}  // cycles
+
+/// @brief Timing of a single benchmark.
+struct Result
+{
+    std::string name;
+    uint64_t iterations = 0;
+    double ns_per_op = 0.0;
+    double cycles_per_op = 0.0;
+};
+
+/// @brief Run benchmarks and report them as a table or as JSON.
+///
+/// Command line options:
+///   --json             Print the results as JSON instead of a table.
+///   --filter <text>    Only run benchmarks whose name contains the text.
+///   --min-time <s>     Minimum measured time per benchmark (default 0.2).
+class Runner
+{
+  private:
+    std::vector<Result> results_;
+    std::string filter_;
+    double min_time_ = 0.2;
+    bool json_ = false;
+
+  public:
+    Runner(int argc, char* argv[])
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const auto arg = std::string_view(argv[i]);
+            if (arg == "--json")
+            {
+                this->json_ = true;
+            }
+            else if (arg == "--filter" && i + 1 < argc)
+            {
+                this->filter_ = argv[++i];
+            }
+            else if (arg == "--min-time" && i + 1 < argc)
+            {
+                this->min_time_ = std::strtod(argv[++i], nullptr);
+            }
+            else
+            {
+                std::fprintf(
+                    stderr,
+                    "usage: %s [--json] [--filter <text>] [--min-time <s>]\n",
+                    argv[0]
+                );
+                std::exit(2);
+            }
+        }
+    }
+
+    /// @brief Time fn, calling it enough times to fill the minimum time.
+    template <typename F>
+    auto run(const std::string& name, F&& fn) -> void
+    {
+        if (!this->filter_.empty() &&
+            name.find(this->filter_) == std::string::npos)
+            return;
+
+        using clock = std::chrono::steady_clock;
+
+        // Warm up caches and branch predictors.
+        fn();
+
+        auto iterations = uint64_t{1};
+        for (;;)
+        {
+            const auto start = clock::now();
+            const auto start_cycles = cycles();
+            for (auto i = uint64_t{0}; i < iterations; ++i) fn();
+            const auto stop_cycles = cycles();
+            const auto elapsed = std::chrono::duration<double>(
+                clock::now() - start
+            ).count();
+
+            if (elapsed >= this->min_time_ || iterations >= (1ULL << 40))
+            {
+                const auto n = static_cast<double>(iterations);
+                this->results_.push_back(
+                    {name,
+                     iterations,
+                     elapsed * 1e9 / n,
+                     static_cast<double>(stop_cycles - start_cycles) / n}
+                );
+                return;
+            }
+
+            // Aim for the minimum time in one more round.
+            const auto scale = elapsed > 0.0 ? this->min_time_ / elapsed : 10.0;
+            const auto next = static_cast<double>(iterations) *
+                              (scale > 10.0 ? 10.0 : scale * 1.2 + 0.1);
+            iterations = static_cast<uint64_t>(next) + 1;
+        }
+    }
+
+    /// @brief Return the results collected so far.
+    [[nodiscard]] auto results() const -> const std::vector<Result>&
+    {
+        return this->results_;
+    }
+
+    /// @brief Return true if JSON output was requested.
+    [[nodiscard]] auto json() const -> bool { return this->json_; }
+
+    /// @brief Print the results in the format selected on the command line.
+    auto report() const -> void
+    {
+        if (this->json_)
+            this->reportJson();
+        else
+            this->reportTable();
+    }
+
+  private:
+    auto reportTable() const -> void
+    {
+        std::printf("%-36s %14s %12s %12s\n", "benchmark", "iterations",
+                    "ns/op", "cycles/op");
+        for (const auto& r : this->results_)
+        {
+            std::printf("%-36s %14llu %12.1f ", r.name.c_str(),
+                        static_cast<unsigned long long>(r.iterations),
+                        r.ns_per_op);
+            if (cycles() != 0)
+                std::printf("%12.0f\n", r.cycles_per_op);
+            else
+                std::printf("%12s\n", "-");
+        }
+    }
+
+    auto reportJson() const -> void
+    {
+        std::printf("{\n  \"benchmarks\": [");
+        for (size_t i = 0; i < this->results_.size(); ++i)
+        {
+            const auto& r = this->results_[i];
+            std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, "
+                        "\"ns_per_op\": %.3f, ",
+                        i == 0 ? "" : ",", r.name.c_str(),
+                        static_cast<unsigned long long>(r.iterations),
+                        r.ns_per_op);
+            if (cycles() != 0)
+                std::printf("\"cycles_per_op\": %.1f}", r.cycles_per_op);
+            else
+                std::printf("\"cycles_per_op\": null}");
+        }
+        std::printf("\n  ]\n}\n");
+    }
+
+};  // Runner
+
+}  // namespace bench
+
+#endif  // VIPER25519_BENCH_HPP_
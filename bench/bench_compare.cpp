@@ -0,0 +1,408 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Run the same Ed25519 and VRF workloads through Viper25519, libsodium, Botan
+// and OpenSSL, check that the libraries agree byte for byte and print the
+// results side by side. Botan and OpenSSL do not implement ECVRF, so the VRF
+// rows compare against libsodium only.
+
+// Standard Library Headers
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+
+// Third-Party Library Headers
+#include <botan/auto_rng.h>
+#include <botan/ed25519.h>
+#include <botan/pubkey.h>
+#include <openssl/evp.h>
+#include "sodium.h"
+
+// Public Viper25519 Headers
+#include <viper25519/ed25519.hpp>
+#include <viper25519/vrf25519.hpp>
+
+// Benchmark harness
+#include "bench.hpp"
+
+namespace
+{
+
+using Seed = std::array<uint8_t, 32>;
+using Signature = std::array<uint8_t, 64>;
+
+constexpr auto libraries =
+    std::array<const char*, 4>{"viper25519", "libsodium", "botan", "openssl"};
+
+// Sign and verify through each library. Key setup is kept out of the timed
+// sign and verify calls where the library allows it.
+
+struct SodiumKey
+{
+    std::array<uint8_t, 32> pk{};
+    std::array<uint8_t, 64> sk{};
+
+    explicit SodiumKey(const Seed& seed)
+    {
+        crypto_sign_seed_keypair(pk.data(), sk.data(), seed.data());
+    }
+
+    [[nodiscard]] auto sign(const std::vector<uint8_t>& msg) const -> Signature
+    {
+        auto sig = Signature{};
+        crypto_sign_detached(
+            sig.data(), nullptr, msg.data(), msg.size(), sk.data()
+        );
+        return sig;
+    }
+
+    [[nodiscard]] auto verify(
+        const std::vector<uint8_t>& msg, const Signature& sig
+    ) const -> bool
+    {
+        return crypto_sign_verify_detached(
+                   sig.data(), msg.data(), msg.size(), pk.data()
+               ) == 0;
+    }
+};  // SodiumKey
+
+struct BotanKey
+{
+    Botan::AutoSeeded_RNG rng;
+    Botan::Ed25519_PrivateKey sk;
+    Botan::PK_Signer signer;
+    Botan::PK_Verifier verifier;
+
+    explicit BotanKey(const Seed& seed)
+        : sk{Botan::secure_vector<uint8_t>(seed.begin(), seed.end())},
+          signer{sk, rng, "Pure"},
+          verifier{sk, "Pure"}
+    {
+    }
+
+    [[nodiscard]] auto publicKey() const -> std::vector<uint8_t>
+    {
+        return sk.public_key_bits();
+    }
+
+    [[nodiscard]] auto sign(const std::vector<uint8_t>& msg) -> Signature
+    {
+        const auto out = signer.sign_message(msg.data(), msg.size(), rng);
+        auto sig = Signature{};
+        std::copy_n(out.begin(), sig.size(), sig.begin());
+        return sig;
+    }
+
+    [[nodiscard]] auto verify(
+        const std::vector<uint8_t>& msg, const Signature& sig
+    ) -> bool
+    {
+        return verifier.verify_message(
+            msg.data(), msg.size(), sig.data(), sig.size()
+        );
+    }
+};  // BotanKey
+
+struct OpenSslKey
+{
+    EVP_PKEY* sk = nullptr;
+    EVP_PKEY* pk = nullptr;
+
+    explicit OpenSslKey(const Seed& seed)
+    {
+        sk = EVP_PKEY_new_raw_private_key(
+            EVP_PKEY_ED25519, nullptr, seed.data(), seed.size()
+        );
+        const auto pub = publicKey();
+        pk = EVP_PKEY_new_raw_public_key(
+            EVP_PKEY_ED25519, nullptr, pub.data(), pub.size()
+        );
+    }
+
+    ~OpenSslKey()
+    {
+        EVP_PKEY_free(pk);
+        EVP_PKEY_free(sk);
+    }
+
+    OpenSslKey(const OpenSslKey&) = delete;
+    auto operator=(const OpenSslKey&) -> OpenSslKey& = delete;
+
+    [[nodiscard]] auto publicKey() const -> std::array<uint8_t, 32>
+    {
+        auto pub = std::array<uint8_t, 32>{};
+        auto len = pub.size();
+        EVP_PKEY_get_raw_public_key(sk, pub.data(), &len);
+        return pub;
+    }
+
+    [[nodiscard]] auto sign(const std::vector<uint8_t>& msg) const
+        -> Signature
+    {
+        auto sig = Signature{};
+        auto len = sig.size();
+        auto* ctx = EVP_MD_CTX_new();
+        EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, sk);
+        EVP_DigestSign(ctx, sig.data(), &len, msg.data(), msg.size());
+        EVP_MD_CTX_free(ctx);
+        return sig;
+    }
+
+    [[nodiscard]] auto verify(
+        const std::vector<uint8_t>& msg, const Signature& sig
+    ) const -> bool
+    {
+        auto* ctx = EVP_MD_CTX_new();
+        EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, pk);
+        const auto ok = EVP_DigestVerify(
+            ctx, sig.data(), sig.size(), msg.data(), msg.size()
+        );
+        EVP_MD_CTX_free(ctx);
+        return ok == 1;
+    }
+};  // OpenSslKey
+
+/// Return a seed that Viper25519 accepts as an RFC 8032 key, i.e. one whose
+/// clamped scalar has the third highest bit clear.
+auto make_seed() -> Seed
+{
+    const auto key = ed25519::PrivateKey::generate();
+    auto seed = Seed{};
+    std::copy(key.bytes().begin(), key.bytes().end(), seed.begin());
+    return seed;
+}  // make_seed
+
+/// Compare keys, signatures and verification results of every library over
+/// a set of random keys and messages. Returns the number of disagreements.
+auto cross_check(size_t rounds) -> size_t
+{
+    auto failures = size_t{0};
+    auto check = [&failures](bool ok, const char* what, size_t round)
+    {
+        if (ok) return;
+        std::fprintf(stderr, "mismatch in round %zu: %s\n", round, what);
+        ++failures;
+    };
+
+    for (size_t i = 0; i < rounds; ++i)
+    {
+        const auto seed = make_seed();
+        auto msg = std::vector<uint8_t>(i * 7);
+        for (size_t j = 0; j < msg.size(); ++j)
+            msg[j] = static_cast<uint8_t>(seed[j % seed.size()] ^ j);
+
+        const auto viper = ed25519::PrivateKey(seed);
+        const auto viper_pub = viper.publicKey();
+        const auto sodium = SodiumKey(seed);
+        auto botan = BotanKey(seed);
+        const auto openssl = OpenSslKey(seed);
+
+        const auto pub = viper_pub.bytes();
+        const auto botan_pub = botan.publicKey();
+        const auto openssl_pub = openssl.publicKey();
+        check(std::equal(pub.begin(), pub.end(), sodium.pk.begin()),
+              "libsodium public key", i);
+        check(std::equal(pub.begin(), pub.end(), botan_pub.begin(),
+                         botan_pub.end()),
+              "botan public key", i);
+        check(std::equal(pub.begin(), pub.end(), openssl_pub.begin()),
+              "openssl public key", i);
+
+        const auto sig = viper.sign(msg);
+        check(sodium.sign(msg) == sig, "libsodium signature", i);
+        check(botan.sign(msg) == sig, "botan signature", i);
+        check(openssl.sign(msg) == sig, "openssl signature", i);
+
+        check(viper_pub.verifySignature(msg, sig), "viper25519 verify", i);
+        check(sodium.verify(msg, sig), "libsodium verify", i);
+        check(botan.verify(msg, sig), "botan verify", i);
+        check(openssl.verify(msg, sig), "openssl verify", i);
+
+        // A corrupted signature must be rejected by everyone.
+        auto bad = sig;
+        bad[i % bad.size()] ^= 0x01;
+        check(viper_pub.tryVerifySignature(msg, bad) !=
+                  ed25519::VerifyResult::Valid,
+              "viper25519 rejects", i);
+        check(!sodium.verify(msg, bad), "libsodium rejects", i);
+        check(!botan.verify(msg, bad), "botan rejects", i);
+        check(!openssl.verify(msg, bad), "openssl rejects", i);
+
+        // VRF proofs and hashes against the libsodium reference.
+        auto vrf_key = ed25519::VRFSecretKey::fromSeed(seed);
+        const auto proof = vrf_key.constructProof(msg);
+        auto ref_proof = std::array<uint8_t, 80>{};
+        crypto_vrf_ietfdraft03_prove(
+            ref_proof.data(), vrf_key.bytes().data(), msg.data(), msg.size()
+        );
+        check(proof == ref_proof, "libsodium vrf proof", i);
+        check(vrf_key.publicKey().verifyProof(msg, proof), "vrf verify", i);
+        auto ref_hash = std::array<uint8_t, 64>{};
+        crypto_vrf_ietfdraft03_proof_to_hash(ref_hash.data(), proof.data());
+        check(ed25519::VRFSecretKey::proofToHash(proof) == ref_hash,
+              "libsodium vrf hash", i);
+    }
+    return failures;
+}  // cross_check
+
+/// Print one row per operation and one column per library.
+auto print_table(const std::vector<bench::Result>& results) -> void
+{
+    auto table = std::map<std::string, std::map<std::string, double>>();
+    auto order = std::vector<std::string>();
+    for (const auto& r : results)
+    {
+        const auto slash = r.name.find('/');
+        const auto op = r.name.substr(0, slash);
+        if (!table.contains(op)) order.push_back(op);
+        table[op][r.name.substr(slash + 1)] = r.ns_per_op;
+    }
+
+    std::printf("\nlatency (us/op) and throughput (op/s)\n%-18s", "");
+    for (const auto* lib : libraries) std::printf(" %22s", lib);
+    std::printf("\n");
+    for (const auto& op : order)
+    {
+        std::printf("%-18s", op.c_str());
+        for (const auto* lib : libraries)
+        {
+            const auto it = table[op].find(lib);
+            if (it == table[op].end())
+            {
+                std::printf(" %22s", "-");
+                continue;
+            }
+            std::printf(" %9.2f us %8.0f/s", it->second / 1e3,
+                        1e9 / it->second);
+        }
+        std::printf("\n");
+    }
+}  // print_table
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto runner = bench::Runner(argc, argv);
+
+    if (sodium_init() < 0)
+    {
+        std::fprintf(stderr, "sodium_init failed\n");
+        return 1;
+    }
+
+    const auto failures = cross_check(64);
+    if (failures != 0)
+    {
+        std::fprintf(stderr, "%zu cross-check failures\n", failures);
+        return 1;
+    }
+
+    const auto seed = make_seed();
+    auto msg = std::vector<uint8_t>(64);
+    for (size_t i = 0; i < msg.size(); ++i)
+        msg[i] = static_cast<uint8_t>(i * 37 + 11);
+
+    const auto viper = ed25519::PrivateKey(seed).extend();
+    const auto viper_pub = viper.publicKey();
+    const auto sodium = SodiumKey(seed);
+    auto botan = BotanKey(seed);
+    const auto openssl = OpenSslKey(seed);
+    const auto sig = viper.sign(msg);
+
+    // Key generation from a fixed seed, i.e. deriving the public key.
+    runner.run("keygen/viper25519", [&] {
+        bench::doNotOptimize(ed25519::PrivateKey(seed).publicKey());
+    });
+    runner.run("keygen/libsodium", [&] {
+        bench::doNotOptimize(SodiumKey(seed));
+    });
+    runner.run("keygen/botan", [&] {
+        bench::doNotOptimize(Botan::Ed25519_PrivateKey(
+            Botan::secure_vector<uint8_t>(seed.begin(), seed.end())
+        ));
+    });
+    runner.run("keygen/openssl", [&] {
+        bench::doNotOptimize(OpenSslKey(seed).publicKey());
+    });
+
+    runner.run("sign/viper25519", [&] {
+        bench::doNotOptimize(viper.sign(msg));
+    });
+    runner.run("sign/libsodium", [&] {
+        bench::doNotOptimize(sodium.sign(msg));
+    });
+    runner.run("sign/botan", [&] { bench::doNotOptimize(botan.sign(msg)); });
+    runner.run("sign/openssl", [&] {
+        bench::doNotOptimize(openssl.sign(msg));
+    });
+
+    runner.run("verify/viper25519", [&] {
+        bench::doNotOptimize(viper_pub.tryVerifySignature(msg, sig));
+    });
+    runner.run("verify/libsodium", [&] {
+        bench::doNotOptimize(sodium.verify(msg, sig));
+    });
+    runner.run("verify/botan", [&] {
+        bench::doNotOptimize(botan.verify(msg, sig));
+    });
+    runner.run("verify/openssl", [&] {
+        bench::doNotOptimize(openssl.verify(msg, sig));
+    });
+
+    auto vrf_key = ed25519::VRFSecretKey::fromSeed(seed);
+    const auto vrf_pub = vrf_key.publicKey();
+    const auto proof = vrf_key.constructProof(msg);
+    auto out = std::array<uint8_t, 80>{};
+    runner.run("vrf_prove/viper25519", [&] {
+        bench::doNotOptimize(vrf_key.constructProof(msg));
+    });
+    runner.run("vrf_prove/libsodium", [&] {
+        crypto_vrf_ietfdraft03_prove(
+            out.data(), vrf_key.bytes().data(), msg.data(), msg.size()
+        );
+        bench::doNotOptimize(out);
+    });
+    runner.run("vrf_verify/viper25519", [&] {
+        bench::doNotOptimize(vrf_pub.verifyProof(msg, proof));
+    });
+    runner.run("vrf_verify/libsodium", [&] {
+        bench::doNotOptimize(crypto_vrf_ietfdraft03_verify(
+            out.data(), vrf_pub.bytes().data(), proof.data(), msg.data(),
+            msg.size()
+        ));
+    });
+    runner.run("vrf_hash/viper25519", [&] {
+        bench::doNotOptimize(ed25519::VRFSecretKey::proofToHash(proof));
+    });
+    runner.run("vrf_hash/libsodium", [&] {
+        crypto_vrf_ietfdraft03_proof_to_hash(out.data(), proof.data());
+        bench::doNotOptimize(out);
+    });
+
+    if (runner.json())
+        runner.report();
+    else
+        print_table(runner.results());
+    return 0;
+}
@@ -0,0 +1,173 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Microbenchmarks of each layer of the library, from field arithmetic up to
+// signatures and VRF proofs.
+
+// Standard Library Headers
+#include <array>
+#include <cstdio>
+#include <span>
+#include <vector>
+
+// Public Viper25519 Headers
+#include <viper25519/curve25519.hpp>
+#include <viper25519/ed25519.hpp>
+#include <viper25519/perf_counters.hpp>
+#include <viper25519/vrf25519.hpp>
+
+// Benchmark harness
+#include "bench.hpp"
+
+using namespace curve25519;
+
+auto main(int argc, char* argv[]) -> int
+{
+    auto runner = bench::Runner(argc, argv);
+
+    // Collect hardware counters when the library is instrumented.
+    ed25519::PerfCounters::setEnabled(true);
+
+    // Inputs are derived from a fixed key so that runs are comparable.
+    auto seed = std::array<uint8_t, 64>{};
+    for (size_t i = 0; i < seed.size(); ++i)
+        seed[i] = static_cast<uint8_t>(i * 37 + 11);
+
+    const auto prv_key = ed25519::PrivateKey(std::span(seed).first<32>());
+    const auto ext_key = prv_key.extend();
+    const auto pub_key = prv_key.publicKey();
+    const auto msg = std::vector<uint8_t>(seed.begin(), seed.end());
+    const auto sig = prv_key.sign(msg);
+
+    const auto s1 = bignum25519::expand256_modm(seed);
+    const auto s2 = bignum25519::expand256_modm(std::span(seed).last<32>());
+    const auto fe = bignum25519::expand(std::span(seed).first<32>());
+    const auto point = ExtendedPoint::multiplyBasepointByScalar(s1);
+    const auto packed = point.pack();
+
+    // Reference workload for the perf gate, which compares the other
+    // benchmarks to it rather than to absolute timings. It is a dependent
+    // chain of 64-bit multiplications like the field arithmetic, but does
+    // not use the library, so a regression in the library cannot hide in it.
+    auto mix = uint64_t{0x9e3779b97f4a7c15};
+    runner.run("calibration/mul_chain", [&] {
+        for (auto i = 0; i < 1024; ++i)
+        {
+            mix ^= mix >> 29;
+            mix *= 0xbf58476d1ce4e5b9;
+        }
+    });
+    bench::doNotOptimize(mix);
+
+    // Field arithmetic
+    auto acc = fe;
+    runner.run("field/mul", [&] { acc = acc.mul(fe); });
+    runner.run("field/square", [&] { acc = acc.square(); });
+    runner.run("field/recip", [&] { acc = acc.recip(); });
+    bench::doNotOptimize(acc);
+
+    // Scalar arithmetic
+    runner.run("scalar/reduce512", [&] {
+        bench::doNotOptimize(bignum25519::expand256_modm(seed));
+    });
+    runner.run("scalar/mul", [&] {
+        bench::doNotOptimize(bignum25519::mul256_modm(s1, s2));
+    });
+
+    // Group operations
+    runner.run("point/basepoint_mul", [&] {
+        bench::doNotOptimize(ExtendedPoint::multiplyBasepointByScalar(s1));
+    });
+    runner.run("point/double_scalar_mul", [&] {
+        bench::doNotOptimize(point.doubleScalarMultiple(s1, s2));
+    });
+    runner.run("point/pack", [&] { bench::doNotOptimize(point.pack()); });
+    runner.run("point/unpack", [&] {
+        bench::doNotOptimize(ExtendedPoint::tryUnpack(packed));
+    });
+
+    // Ed25519
+    runner.run("ed25519/keygen", [&] {
+        bench::doNotOptimize(ed25519::PrivateKey::generate());
+    });
+    runner.run("ed25519/public_key", [&] {
+        bench::doNotOptimize(prv_key.publicKey());
+    });
+    runner.run("ed25519/sign", [&] {
+        bench::doNotOptimize(ext_key.sign(msg));
+    });
+    runner.run("ed25519/verify", [&] {
+        bench::doNotOptimize(pub_key.tryVerifySignature(msg, sig));
+    });
+
+    // VRF
+    auto vrf_key = ed25519::VRFSecretKey::fromSeed(std::span(seed).first<32>());
+    const auto vrf_pub = vrf_key.publicKey();
+    const auto proof = vrf_key.constructProof(msg);
+    runner.run("vrf/prove", [&] {
+        bench::doNotOptimize(vrf_key.constructProof(msg));
+    });
+    const auto prepared = ed25519::PreparedVRFSecretKey(vrf_key);
+    runner.run("vrf/prepared_prove", [&] {
+        bench::doNotOptimize(prepared.constructProof(msg));
+    });
+    runner.run("vrf/prepared_prove_and_hash", [&] {
+        bench::doNotOptimize(prepared.constructProofAndHash(msg));
+    });
+    const auto vrf_msgs =
+        std::vector<std::span<const uint8_t>>(64, std::span(msg));
+    runner.run("vrf/prove_and_hash_batch64", [&] {
+        bench::doNotOptimize(prepared.constructProofAndHashBatch(vrf_msgs));
+    });
+    runner.run("vrf/hash_batch64", [&] {
+        bench::doNotOptimize(prepared.hashBatch(vrf_msgs));
+    });
+    runner.run("vrf/verify", [&] {
+        bench::doNotOptimize(vrf_pub.verifyProof(msg, proof));
+    });
+    runner.run("vrf/proof_to_hash", [&] {
+        bench::doNotOptimize(ed25519::VRFSecretKey::proofToHash(proof));
+    });
+    runner.run("vrf/verify_and_hash", [&] {
+        bench::doNotOptimize(vrf_pub.verifyProofAndHash(msg, proof));
+    });
+
+    runner.report();
+
+    if (!runner.json() && ed25519::PerfCounters::available())
+    {
+        std::printf("\n%-20s %12s %12s %8s %14s %12s\n", "operation",
+                    "calls", "cycles/op", "IPC", "br-miss/op", "L1D-miss/op");
+        for (size_t i = 0; i < ed25519::OPERATION_COUNT; ++i)
+        {
+            const auto op = static_cast<ed25519::Operation>(i);
+            const auto st = ed25519::PerfCounters::stats(op);
+            if (st.calls == 0) continue;
+            const auto n = static_cast<double>(st.calls);
+            std::printf("%-20s %12llu %12.0f %8.2f %14.1f %12.1f\n",
+                        ed25519::operationName(op).data(),
+                        static_cast<unsigned long long>(st.calls),
+                        static_cast<double>(st.cycles) / n, st.ipc(),
+                        static_cast<double>(st.branch_misses) / n,
+                        static_cast<double>(st.l1d_misses) / n);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,173 @@
+# Performance regression gate, run by CTest in script mode:
+#
+#   cmake -DBENCH=<bench_viper25519> -DBASELINE=<baseline.json>
+#         [-DOUTPUT=<results.json>] -P PerfGate.cmake
+#
+# Runs the benchmark suite with the workload given in the baseline and fails
+# if the throughput of any benchmark listed in the baseline dropped by more
+# than its tolerance. Timings are compared as ratios to the calibration
+# benchmark named in the baseline, which runs in the same process, so that
+# the baseline carries over between machines of different speeds. The
+# measured ratios are written to OUTPUT so that they can be copied into the
+# baseline after an intended change.
+
+cmake_minimum_required(VERSION 3.23)
+
+if(NOT BENCH OR NOT BASELINE)
+    message(FATAL_ERROR "PerfGate.cmake requires -DBENCH and -DBASELINE")
+endif()
+
+# Convert a decimal string to an integer scaled by 10^digits, since
+# math(EXPR) only handles integers. The value is rounded to the nearest
+# integer, as JSON numbers may come back as e.g. 1.2999999.
+function(to_fixed value digits out)
+    if(NOT value MATCHES "^([0-9]+)(\\.([0-9]*))?$")
+        message(FATAL_ERROR "Invalid number '${value}'")
+    endif()
+    set(whole "${CMAKE_MATCH_1}")
+    set(frac "${CMAKE_MATCH_3}0000000")
+    math(EXPR length "${digits} + 1")
+    string(SUBSTRING "${frac}" 0 ${length} frac)
+    set(scale 10)
+    foreach(i RANGE 1 ${digits})
+        math(EXPR scale "${scale} * 10")
+    endforeach()
+    math(EXPR fixed "(${whole} * ${scale} + ${frac} + 5) / 10")
+    set(${out} ${fixed} PARENT_SCOPE)
+endfunction()
+
+# Format a ratio in millionths as a decimal with six places.
+function(format_ratio ppm out)
+    math(EXPR whole "${ppm} / 1000000")
+    math(EXPR frac "${ppm} % 1000000 + 1000000")
+    string(SUBSTRING "${frac}" 1 6 frac)
+    set(${out} "${whole}.${frac}" PARENT_SCOPE)
+endfunction()
+
+# Read a tolerance, which must be a whole number of percent.
+function(to_tolerance value out)
+    if(NOT value MATCHES "^[0-9]+$")
+        message(FATAL_ERROR
+            "Invalid tolerance '${value}', expected an integer percentage")
+    endif()
+    set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+file(READ "${BASELINE}" baseline)
+string(JSON min_time GET "${baseline}" min_time)
+string(JSON repetitions GET "${baseline}" repetitions)
+string(JSON calibration GET "${baseline}" calibration)
+string(JSON default_tolerance GET "${baseline}" default_tolerance_percent)
+to_tolerance(${default_tolerance} default_tolerance)
+string(JSON baseline_count LENGTH "${baseline}" benchmarks)
+
+# Each run of the suite gives the time of every benchmark relative to the
+# calibration of the same run, in millionths. The lowest ratio of several
+# runs is kept, which is far less sensitive to interference from the rest of
+# the machine than the mean.
+set(names "")
+foreach(run RANGE 1 ${repetitions})
+    execute_process(
+        COMMAND "${BENCH}" --json --min-time ${min_time}
+        OUTPUT_VARIABLE results
+        RESULT_VARIABLE status
+    )
+    if(NOT status EQUAL 0)
+        message(FATAL_ERROR "${BENCH} failed: ${status}")
+    endif()
+
+    string(JSON result_count LENGTH "${results}" benchmarks)
+    math(EXPR last "${result_count} - 1")
+    unset(calibration_ps)
+    foreach(i RANGE ${last})
+        string(JSON name GET "${results}" benchmarks ${i} name)
+        if(name STREQUAL calibration)
+            string(JSON ns GET "${results}" benchmarks ${i} ns_per_op)
+            to_fixed(${ns} 3 calibration_ps)
+        endif()
+    endforeach()
+    if(NOT calibration_ps)
+        message(FATAL_ERROR "Calibration benchmark ${calibration} not timed")
+    endif()
+
+    foreach(i RANGE ${last})
+        string(JSON name GET "${results}" benchmarks ${i} name)
+        string(JSON ns GET "${results}" benchmarks ${i} ns_per_op)
+        to_fixed(${ns} 3 ps)
+        math(EXPR ppm "${ps} * 1000000 / ${calibration_ps}")
+        if(NOT DEFINED "ratio_${name}")
+            list(APPEND names ${name})
+            set("ratio_${name}" ${ppm})
+        elseif(ppm LESS "${ratio_${name}}")
+            set("ratio_${name}" ${ppm})
+        endif()
+    endforeach()
+endforeach()
+
+# Write the measurements in the format of the baseline.
+if(OUTPUT)
+    set(entries "")
+    foreach(name IN LISTS names)
+        if(name STREQUAL calibration)
+            continue()
+        endif()
+        format_ratio(${ratio_${name}} ratio)
+        list(APPEND entries "        \"${name}\": {\"ratio\": ${ratio}}")
+    endforeach()
+    list(JOIN entries ",\n" entries)
+    file(WRITE "${OUTPUT}"
+         "{\n    \"calibration\": \"${calibration}\",\n"
+         "    \"benchmarks\": {\n${entries}\n    }\n}\n")
+endif()
+
+set(failures "")
+math(EXPR last "${baseline_count} - 1")
+foreach(i RANGE ${last})
+    string(JSON name MEMBER "${baseline}" benchmarks ${i})
+    string(JSON expected GET "${baseline}" benchmarks ${name} ratio)
+    string(JSON tolerance ERROR_VARIABLE no_tolerance
+           GET "${baseline}" benchmarks ${name} tolerance_percent)
+    if(no_tolerance)
+        set(tolerance ${default_tolerance})
+    else()
+        to_tolerance(${tolerance} tolerance)
+    endif()
+
+    if(NOT DEFINED "ratio_${name}")
+        list(APPEND failures "${name} (not run)")
+        continue()
+    endif()
+
+    # Throughput change in tenths of a percent: (expected / actual - 1).
+    to_fixed(${expected} 6 expected_ppm)
+    set(actual_ppm ${ratio_${name}})
+    if(actual_ppm EQUAL 0)
+        set(actual_ppm 1)
+    endif()
+    math(EXPR change
+         "(${expected_ppm} - ${actual_ppm}) * 1000 / ${actual_ppm}")
+    set(sign "+")
+    set(magnitude ${change})
+    if(change LESS 0)
+        set(sign "-")
+        math(EXPR magnitude "0 - ${change}")
+    endif()
+    math(EXPR whole "${magnitude} / 10")
+    math(EXPR tenth "${magnitude} % 10")
+    set(change_text "${sign}${whole}.${tenth}%")
+
+    format_ratio(${expected_ppm} expected)
+    format_ratio(${actual_ppm} actual)
+    message(STATUS "${name}: baseline ratio ${expected}, measured ${actual}, "
+                   "throughput ${change_text} (limit -${tolerance}%)")
+
+    math(EXPR limit "0 - ${tolerance} * 10")
+    if(change LESS limit)
+        list(APPEND failures "${name} (${change_text})")
+    endif()
+endforeach()
+
+if(failures)
+    list(JOIN failures ", " failures)
+    message(FATAL_ERROR "Throughput regression: ${failures}")
+endif()
@@ -0,0 +1,107 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_BATCH_VERIFIER_HPP_
+#define VIPER25519_BATCH_VERIFIER_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <viper25519/ed25519.hpp>
+#include <viper25519/thread_pool.hpp>
+
+namespace ed25519
+{
+
+/// @brief Verify many signatures in parallel.
+/// Signatures are collected with add and checked together by verify. The
+/// items are split into chunks that run on a thread pool, either one passed
+/// to the constructor or one owned by the verifier.
+///
+/// Under VerifyMode::Zip215 each chunk is checked with a single randomized
+/// multi-scalar equation, falling back to checking items one at a time only
+/// when the chunk fails. Under the other modes the cofactorless equation does
+/// not batch consistently, so the items of each chunk are checked one at a
+/// time. Either way the result for every item equals that of
+/// PublicKey::verifySignature with the same mode.
+class BatchVerifier
+{
+  public:
+    /// Number of signatures checked together by a single task.
+    static constexpr size_t CHUNK_SIZE = 64;
+
+    /// @brief Create a verifier that starts its own thread pool when needed.
+    /// @param mode The rules the signatures are checked under.
+    explicit BatchVerifier(VerifyMode mode = VerifyMode::Zip215);
+
+    /// @brief Create a verifier that runs on the given thread pool.
+    /// @param pool A pool that outlives the verifier.
+    /// @param mode The rules the signatures are checked under.
+    explicit BatchVerifier(
+        ThreadPool& pool, VerifyMode mode = VerifyMode::Zip215
+    );
+
+    /// @brief Queue a signature for verification.
+    /// The message is not copied and must stay valid until verify returns.
+    /// @param key The public key of the signer.
+    /// @param msg A span of bytes (uint8_t) representing the original message.
+    /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    auto add(
+        const PublicKey& key,
+        std::span<const uint8_t> msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+    ) -> void;
+
+    /// @brief Return the number of queued signatures.
+    [[nodiscard]] auto size() const noexcept -> size_t;
+
+    /// @brief Remove all queued signatures.
+    auto clear() noexcept -> void;
+
+    /// @brief Check all queued signatures.
+    /// @returns One flag per signature, in the order added, set if the
+    /// signature is valid.
+    [[nodiscard]] auto verify() -> std::vector<bool>;
+
+  private:
+    struct Item
+    {
+        PublicKey key;
+        std::span<const uint8_t> msg;
+        std::array<uint8_t, ED25519_SIGNATURE_SIZE> sig;
+    };
+
+    VerifyMode mode_;
+    ThreadPool* pool_ = nullptr;
+    std::unique_ptr<ThreadPool> owned_pool_;
+    std::vector<Item> items_;
+
+    auto verifyChunk(size_t first, size_t last, std::span<uint8_t> results)
+        const -> void;
+
+};  // BatchVerifier
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_BATCH_VERIFIER_HPP_
@@ -23,7 +23,9 @@
 
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <span>
+#include <vector>
 
 namespace curve25519
 {
@@ -408,10 +410,35 @@ class ExtendedPoint
 
     [[nodiscard]] auto doubleExtended() const -> ExtendedPoint;
 
+    /// @brief Computes [8]p, clearing any small order component.
+    [[nodiscard]] auto mulByCofactor() const -> ExtendedPoint;
+
+    /// @brief Test whether the point is the neutral element (0, 1).
+    [[nodiscard]] auto isIdentity() const -> bool;
+
     /// @brief Computes [s1]p1 + [s2]basepoint
+    /// The T coordinate of the result is not maintained; pack or double the
+    /// point before adding to it.
     [[nodiscard]] auto doubleScalarMultiple(bignum25519 const &s1, bignum25519 const &s2)
         const -> ExtendedPoint;
 
+    /// @brief Computes [s]p in constant time.
+    /// Use this rather than the variable time routines whenever the scalar is
+    /// secret, e.g. when proving with a VRF key.
+    [[nodiscard]] auto scalarMultiple(bignum25519 const &s) const
+        -> ExtendedPoint;
+
+    /// @brief Computes -p.
+    [[nodiscard]] auto negate() const -> ExtendedPoint;
+
+    /// @brief Computes [s1]p1 + [s2]p2 + ... + [sn]pn in variable time.
+    /// The points and scalars are paired by index and the spans must have the
+    /// same length.
+    [[nodiscard]] static auto multiScalarMultiple(
+        std::span<const bignum25519> scalars,
+        std::span<const ExtendedPoint> points
+    ) -> ExtendedPoint;
+
     /// @brief Computes [s]B
     /// Compute [s]B where B is the curve 25519 basepoint and [s] is a scalar.
     [[nodiscard]] static auto multiplyBasepointByScalar(bignum25519 const &s)
@@ -419,9 +446,23 @@ class ExtendedPoint
 
     [[nodiscard]] auto pack() const -> std::array<uint8_t, 32>;
 
+    /// @brief Pack several points sharing a single field inversion.
+    [[nodiscard]] static auto packBatch(std::span<const ExtendedPoint> points)
+        -> std::vector<std::array<uint8_t, 32>>;
+
+    /// @brief Decode a packed point and return its negation.
+    /// The negated point is what signature verification requires, which is
+    /// why this is the form provided. Throws if the bytes do not encode a
+    /// point on the curve.
     [[nodiscard]] static auto unpack(std::span<const uint8_t> p)
         -> ExtendedPoint;
 
+    /// @brief Non-throwing form of unpack.
+    /// @returns The negated point or std::nullopt if the bytes are not 32
+    /// bytes long or do not encode a point on the curve.
+    [[nodiscard]] static auto tryUnpack(std::span<const uint8_t> p) noexcept
+        -> std::optional<ExtendedPoint>;
+
 };  // class ExtendedPoint
 
 // This function is largely just used for testing.
@@ -24,7 +24,10 @@
 #include <algorithm>
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <span>
+#include <utility>
 #include <vector>
 #include <viper25519/secmem.hpp>
 
@@ -35,16 +38,55 @@ namespace ed25519
 static constexpr size_t ED25519_KEY_SIZE = 32;
 static constexpr size_t ED25519_EXTENDED_KEY_SIZE = 64;
 static constexpr size_t ED25519_SIGNATURE_SIZE = 64;
+static constexpr size_t ED25519_PREHASH_SIZE = 64;
+static constexpr size_t ED25519_MAX_CONTEXT_SIZE = 255;
 
 using KeyByteArray = SecureByteArray<uint8_t, ED25519_KEY_SIZE>;
 using PubKeyByteArray = std::array<uint8_t, ED25519_KEY_SIZE>;
 using ExtKeyByteArray = SecureByteArray<uint8_t, ED25519_EXTENDED_KEY_SIZE>;
 
+/// A message made up of several buffers, signed as their concatenation.
+using MessageSegments = std::span<const std::span<const uint8_t>>;
+
+/// @brief Outcome of a non-throwing signature verification.
+enum class VerifyResult : uint8_t
+{
+    /// The signature is valid for the message and public key.
+    Valid,
+    /// The signature is well formed but does not match.
+    Invalid,
+    /// The signature is malformed (e.g. the scalar S is out of range).
+    MalformedSignature,
+    /// The public key does not encode a point on the curve.
+    MalformedPublicKey
+};
+
+/// @brief Rules applied when checking a signature.
+enum class VerifyMode : uint8_t
+{
+    /// The checks of the reference implementation: only the top three bits
+    /// of S are tested and the cofactorless equation is used.
+    Legacy,
+    /// RFC 8032 strict decoding: S < L, canonical encodings of R and A, and
+    /// rejection of small order R and A before any curve arithmetic.
+    Rfc8032,
+    /// ZIP-215 rules: S < L, non-canonical and small order encodings are
+    /// accepted and the cofactored equation [8][S]B = [8]R + [8][k]A is used.
+    /// Single and batch verification agree under these rules.
+    Zip215
+};
+
 // Forward Declarations
 class PrivateKey;
 class PublicKey;
 class ExtendedPrivateKey;
 
+/// @brief Reseed the random number generators used for key generation.
+/// Key generation draws from a buffered per-thread generator that is seeded by
+/// the operating system. Calling this function reseeds the generator of the
+/// calling thread immediately and every other thread on its next use.
+auto reseedRandomGenerator() -> void;
+
 /// @brief Represent an Ed25519 private key.
 class PrivateKey
 {
@@ -74,6 +116,16 @@ class PrivateKey
     /// cryptographically secure random number generator.
     [[nodiscard]] static auto generate() -> PrivateKey;
 
+    /// @brief Generate many key pairs at once.
+    /// The entropy is drawn from the random number generator in chunks of
+    /// keys that are wiped after use, and the public keys are packed together
+    /// so that only one field inversion is required for the whole batch.
+    /// @param n The number of key pairs to generate.
+    /// @returns A vector of n private keys paired with their public keys.
+    /// @throws std::length_error if n keys would overflow the entropy size.
+    [[nodiscard]] static auto generateBatch(size_t n)
+        -> std::vector<std::pair<PrivateKey, PublicKey>>;
+
     /// @brief Check key validity.
     [[nodiscard]] auto isValid() const -> bool;
 
@@ -88,6 +140,35 @@ class PrivateKey
     [[nodiscard]] auto sign(std::span<const uint8_t> msg) const
         -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
 
+    /// @brief Sign a message supplied as several segments.
+    /// The signature is that of the concatenated segments, which are hashed
+    /// in place rather than copied into a single buffer.
+    /// @param msg The message segments in order.
+    [[nodiscard]] auto sign(MessageSegments msg) const
+        -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
+
+    /// @brief Sign a prehashed message (Ed25519ph, RFC 8032).
+    /// Together with Prehash this signs a message in a single pass.
+    /// @param digest The SHA-512 digest of the message.
+    /// @param context An optional context of at most 255 bytes.
+    [[nodiscard]] auto signPrehashed(
+        std::span<const uint8_t, ED25519_PREHASH_SIZE> digest,
+        std::span<const uint8_t> context = {}
+    ) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
+
+    /// @brief Sign a message bound to a context (Ed25519ctx, RFC 8032).
+    /// @param msg A span of bytes (uint8_t) representing the message to sign.
+    /// @param context A context of 1 to 255 bytes.
+    [[nodiscard]] auto signWithContext(
+        std::span<const uint8_t> msg, std::span<const uint8_t> context
+    ) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
+
+    /// @brief Sign several messages with the private key.
+    /// The signatures are identical to calling sign for each message.
+    /// @param msgs The messages to sign.
+    [[nodiscard]] auto signBatch(std::span<const std::span<const uint8_t>> msgs
+    ) const -> std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>;
+
 };  // PrivateKey
 
 /// @brief Represent an Ed25519 prublic key.
@@ -109,11 +190,72 @@ class PublicKey
     }
 
     /// @brief Verify a signature using the public key.
+    /// The decoded key is taken from the PointCache, and signatures already
+    /// verified are accepted from the SignatureCache, when they are enabled.
     /// @param msg A span of bytes (uint8_t) representing the original message.
     /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    /// @param mode The decoding and equation rules (see VerifyMode).
     [[nodiscard]] auto verifySignature(
         std::span<const uint8_t> msg,
-        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        VerifyMode mode = VerifyMode::Legacy
+    ) const -> bool;
+
+    /// @brief Verify a signature of a message supplied as several segments.
+    /// @param msg The message segments in order.
+    /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    /// @param mode The decoding and equation rules (see VerifyMode).
+    [[nodiscard]] auto verifySignature(
+        MessageSegments msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        VerifyMode mode = VerifyMode::Legacy
+    ) const -> bool;
+
+    /// @brief Verify a signature without throwing on malformed input.
+    /// This performs the same checks as verifySignature but reports malformed
+    /// signatures and keys through the result instead of an exception, which
+    /// keeps the rejection of adversarial input cheap.
+    /// @param msg A span of bytes (uint8_t) representing the original message.
+    /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    /// @param mode The decoding and equation rules (see VerifyMode).
+    [[nodiscard]] auto tryVerifySignature(
+        std::span<const uint8_t> msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        VerifyMode mode = VerifyMode::Legacy
+    ) const noexcept -> VerifyResult;
+
+    /// @brief Non-throwing verification of a message in several segments.
+    /// @param msg The message segments in order.
+    /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    /// @param mode The decoding and equation rules (see VerifyMode).
+    [[nodiscard]] auto tryVerifySignature(
+        MessageSegments msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        VerifyMode mode = VerifyMode::Legacy
+    ) const noexcept -> VerifyResult;
+
+    /// @brief Verify an Ed25519ph signature of a prehashed message.
+    /// @param digest The SHA-512 digest of the message.
+    /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    /// @param context The context used when signing, if any.
+    /// @param mode The decoding and equation rules (see VerifyMode).
+    [[nodiscard]] auto verifyPrehashed(
+        std::span<const uint8_t, ED25519_PREHASH_SIZE> digest,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        std::span<const uint8_t> context = {},
+        VerifyMode mode = VerifyMode::Legacy
+    ) const -> bool;
+
+    /// @brief Verify an Ed25519ctx signature.
+    /// @param msg A span of bytes (uint8_t) representing the original message.
+    /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    /// @param context The context used when signing.
+    /// @param mode The decoding and equation rules (see VerifyMode).
+    [[nodiscard]] auto verifyWithContext(
+        std::span<const uint8_t> msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        std::span<const uint8_t> context,
+        VerifyMode mode = VerifyMode::Legacy
     ) const -> bool;
 
     /// @brief Add two public keys as curve25519 points.
@@ -124,8 +266,80 @@ class PublicKey
     /// @returns A public key that is the result of the summation.
     [[nodiscard]] auto pointAdd(const PublicKey& rhs) const -> PublicKey;
 
+    /// @brief Non-throwing form of pointAdd.
+    /// @returns The summed public key or std::nullopt if either key does not
+    /// encode a point on the curve.
+    [[nodiscard]] auto tryPointAdd(const PublicKey& rhs) const noexcept
+        -> std::optional<PublicKey>;
+
 };  // PublicKey
 
+/// @brief Verify a signature over a message supplied incrementally.
+/// The message is hashed as it arrives, so arbitrarily large inputs (e.g.
+/// files streamed from disk) are verified in constant memory. The encodings
+/// of the key and signature are checked by init, before any input is hashed.
+/// A moved-from verifier behaves like one that was never initialised: update
+/// and final throw std::logic_error until init is called again.
+class Verifier
+{
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+  public:
+    Verifier();
+    ~Verifier();
+    Verifier(Verifier&&) noexcept;
+    auto operator=(Verifier&&) noexcept -> Verifier&;
+
+    /// @brief Start verifying a signature, discarding any previous input.
+    /// @param key The public key of the signer.
+    /// @param sig A span of 64 bytes (uint8_t) representing the signature.
+    /// @param mode The decoding and equation rules (see VerifyMode).
+    auto init(
+        const PublicKey& key,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        VerifyMode mode = VerifyMode::Legacy
+    ) -> void;
+
+    /// @brief Append the next part of the message.
+    auto update(std::span<const uint8_t> chunk) -> void;
+
+    /// @brief Finish the message and check the signature.
+    /// Throws on malformed input in the same way as verifySignature. The
+    /// verifier must be initialised again before further use.
+    [[nodiscard]] auto final() -> bool;
+
+    /// @brief Non-throwing form of final.
+    /// @returns VerifyResult::Invalid if the verifier is not initialised.
+    [[nodiscard]] auto tryFinal() noexcept -> VerifyResult;
+
+};  // Verifier
+
+/// @brief Incremental SHA-512 of a message for Ed25519ph.
+/// The digest returned by final is the input of signPrehashed and
+/// verifyPrehashed, allowing messages of any size to be signed in one pass.
+/// A moved-from object is reset to an empty message.
+class Prehash
+{
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+  public:
+    Prehash();
+    ~Prehash();
+    Prehash(Prehash&&) noexcept;
+    auto operator=(Prehash&&) noexcept -> Prehash&;
+
+    /// @brief Append the next part of the message.
+    auto update(std::span<const uint8_t> chunk) -> void;
+
+    /// @brief Return the digest and reset for a new message.
+    [[nodiscard]] auto final() -> std::array<uint8_t, ED25519_PREHASH_SIZE>;
+
+};  // Prehash
+
 /// @brief Represent an extended Ed25519 private key.
 class ExtendedPrivateKey
 {
@@ -133,6 +347,11 @@ class ExtendedPrivateKey
     /// Private key byte array (unencrypted)
     ExtKeyByteArray prv_{};
 
+    /// Sign with an RFC 8032 domain prefix (empty for pure Ed25519).
+    [[nodiscard]] auto signWithDomain(
+        std::span<const uint8_t> dom, MessageSegments msg
+    ) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
+
     /// Make the default constructor private so that it can only be used
     /// internally.
     ExtendedPrivateKey() = default;
@@ -168,6 +387,37 @@ class ExtendedPrivateKey
     [[nodiscard]] auto sign(std::span<const uint8_t> msg) const
         -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
 
+    /// @brief Sign a message supplied as several segments.
+    /// The signature is that of the concatenated segments, which are hashed
+    /// in place rather than copied into a single buffer.
+    /// @param msg The message segments in order.
+    [[nodiscard]] auto sign(MessageSegments msg) const
+        -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
+
+    /// @brief Sign a prehashed message (Ed25519ph, RFC 8032).
+    /// Together with Prehash this signs a message in a single pass.
+    /// @param digest The SHA-512 digest of the message.
+    /// @param context An optional context of at most 255 bytes.
+    [[nodiscard]] auto signPrehashed(
+        std::span<const uint8_t, ED25519_PREHASH_SIZE> digest,
+        std::span<const uint8_t> context = {}
+    ) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
+
+    /// @brief Sign a message bound to a context (Ed25519ctx, RFC 8032).
+    /// @param msg A span of bytes (uint8_t) representing the message to sign.
+    /// @param context A context of 1 to 255 bytes.
+    [[nodiscard]] auto signWithContext(
+        std::span<const uint8_t> msg, std::span<const uint8_t> context
+    ) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>;
+
+    /// @brief Sign several messages with the private key.
+    /// The signatures are identical to calling sign for each message, but the
+    /// public key and secret scalar are derived once and the R points of all
+    /// signatures are encoded with a single field inversion.
+    /// @param msgs The messages to sign.
+    [[nodiscard]] auto signBatch(std::span<const std::span<const uint8_t>> msgs
+    ) const -> std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>;
+
     /// @brief Add the lower bytes of two secret keys as scalar values.
     /// Add the lower 32 bytes of two extended secret keys as two large scalars.
     /// The result is a 32 byte array. This may be used during child key
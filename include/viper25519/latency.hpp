@@ -0,0 +1,122 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_LATENCY_HPP_
+#define VIPER25519_LATENCY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <viper25519/operation.hpp>
+
+namespace ed25519
+{
+
+/// @brief Latency statistics of one operation in nanoseconds.
+/// Percentiles are read from the histogram and are accurate to about 3%.
+struct LatencySummary
+{
+    uint64_t count = 0;
+    double min_ns = 0.0;
+    double mean_ns = 0.0;
+    double p50_ns = 0.0;
+    double p90_ns = 0.0;
+    double p99_ns = 0.0;
+    double p999_ns = 0.0;
+    double max_ns = 0.0;
+};
+
+/// @brief Process-wide latency histograms per operation.
+/// When the library is built with VIPER25519_LATENCY and recording is
+/// enabled, each operation listed in Operation (including nested ones, e.g.
+/// the decoding inside a verification) reads the time stamp counter on entry
+/// and exit, also when it exits by an exception, and adds the duration to a
+/// log-linear histogram with 32 buckets per power of two. Recording costs two
+/// counter reads and a few relaxed atomic additions; when disabled only a
+/// flag is tested. Without VIPER25519_LATENCY the operations are not timed at
+/// all and only durations passed to record are kept. Recording is off until
+/// enabled.
+class LatencyRecorder
+{
+  public:
+    /// Number of histogram buckets kept per operation.
+    static constexpr size_t BUCKET_COUNT = 1920;
+
+    /// @brief Start or stop recording.
+    static auto setEnabled(bool enabled) noexcept -> void;
+
+    /// @brief Return true if latencies are being recorded.
+    [[nodiscard]] static auto enabled() noexcept -> bool;
+
+    /// @brief Return true if the library was built with VIPER25519_LATENCY,
+    /// i.e. if its operations record their own latencies.
+    [[nodiscard]] static auto available() noexcept -> bool;
+
+    /// @brief Discard all recorded latencies.
+    static auto reset() noexcept -> void;
+
+    /// @brief Add a duration measured in counter ticks to an operation.
+    /// Used by LatencyScope; exposed so that callers can feed their own
+    /// measurements of an operation into the same histograms.
+    static auto record(Operation op, uint64_t ticks) noexcept -> void;
+
+    /// @brief Return the latency below which the fraction q of the recorded
+    /// calls fall, in nanoseconds (zero if nothing was recorded).
+    [[nodiscard]] static auto percentile(Operation op, double q) -> double;
+
+    /// @brief Return the count, extremes, mean and common percentiles.
+    [[nodiscard]] static auto summary(Operation op) -> LatencySummary;
+
+    /// @brief Format the summaries of all recorded operations as a table.
+    [[nodiscard]] static auto dumpText() -> std::string;
+
+    /// @brief Format the summaries and the non-empty histogram buckets of
+    /// all recorded operations as JSON.
+    [[nodiscard]] static auto dumpJson() -> std::string;
+
+    /// @brief Read the clock used for recording.
+    /// This is the time stamp counter on x86 and a nanosecond steady clock
+    /// elsewhere.
+    [[nodiscard]] static auto ticks() noexcept -> uint64_t;
+
+};  // LatencyRecorder
+
+/// @brief Record the duration of its lifetime for an operation.
+/// Used by the library's instrumentation hooks.
+class LatencyScope
+{
+  private:
+    uint64_t start_ = 0;
+    Operation op_;
+    bool active_;
+
+  public:
+    explicit LatencyScope(Operation op) noexcept;
+    ~LatencyScope();
+
+    LatencyScope(const LatencyScope&) = delete;
+    auto operator=(const LatencyScope&) -> LatencyScope& = delete;
+
+};  // LatencyScope
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_LATENCY_HPP_
@@ -0,0 +1,124 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_LEADER_SCHEDULE_HPP_
+#define VIPER25519_LEADER_SCHEDULE_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <viper25519/thread_pool.hpp>
+#include <viper25519/vrf25519.hpp>
+
+namespace ed25519
+{
+
+/// Number of slots in a Cardano mainnet epoch.
+static constexpr uint64_t EPOCH_SLOT_COUNT = 432000;
+
+/// @brief A slot won by the key, with the proof that shows it.
+struct LeaderSlot
+{
+    uint64_t slot;
+    std::array<uint8_t, ED25519_VRF_PROOF_SIZE> proof;
+    std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE> hash;
+};
+
+/// @brief The slots a LeaderScheduler evaluates and how.
+struct LeaderScheduleOptions
+{
+    /// The first slot of the epoch.
+    uint64_t firstSlot = 0;
+    /// The number of slots to evaluate.
+    uint64_t slotCount = EPOCH_SLOT_COUNT;
+    /// The VRF variant to prove with.
+    VRFSuite suite = VRFSuite::IetfDraft03;
+    /// Slots hashed together by one task, sharing their field inversion.
+    size_t chunkSize = 64;
+};
+
+/// @brief Return the Praos VRF input of a slot.
+/// The input is BLAKE2b-256 of the slot number (8 bytes, big endian)
+/// followed by the epoch nonce, as used by Cardano since Babbage.
+/// @param slot The absolute slot number.
+/// @param epochNonce The 32 byte nonce of the epoch.
+[[nodiscard]] auto praosSlotInput(
+    uint64_t slot, std::span<const uint8_t, 32> epochNonce
+) -> std::array<uint8_t, 32>;
+
+/// @brief Evaluate the VRF for every slot of an epoch in parallel.
+/// The slots are split into chunks that are hashed on a thread pool with a
+/// prepared key, computing only Gamma for each slot. A predicate decides
+/// which slots the key leads, and proofs are constructed for those alone.
+class LeaderScheduler
+{
+  public:
+    using Options = LeaderScheduleOptions;
+
+    /// Return the VRF input of a slot.
+    using SlotInput = std::function<std::vector<uint8_t>(uint64_t slot)>;
+
+    /// Return true if the VRF hash of the slot makes the key its leader.
+    using LeaderPredicate = std::function<bool(
+        uint64_t slot,
+        std::span<const uint8_t, ED25519_VRF_PROOF_HASH_SIZE> hash
+    )>;
+
+    /// @brief Create a scheduler that runs on its own thread pool.
+    LeaderScheduler();
+
+    /// @brief Create a scheduler that runs on the given thread pool.
+    /// @param pool A pool that outlives the scheduler.
+    explicit LeaderScheduler(ThreadPool& pool);
+
+    ~LeaderScheduler();
+
+    LeaderScheduler(const LeaderScheduler&) = delete;
+    auto operator=(const LeaderScheduler&) -> LeaderScheduler& = delete;
+
+    /// @brief Compute the slots led by a key.
+    /// The input and predicate are called concurrently from the threads of
+    /// the pool and must be safe to call in that way.
+    /// @param key The prepared VRF key of the pool.
+    /// @param input Derives the VRF input of each slot.
+    /// @param isLeader Selects the slots the key leads.
+    /// @param options The slots to evaluate.
+    /// @return The led slots in increasing order with their proofs.
+    [[nodiscard]] auto compute(
+        const PreparedVRFSecretKey& key,
+        const SlotInput& input,
+        const LeaderPredicate& isLeader,
+        Options options = {}
+    ) -> std::vector<LeaderSlot>;
+
+  private:
+    std::unique_ptr<ThreadPool> owned_pool_;
+    ThreadPool* pool_;
+
+};  // LeaderScheduler
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_LEADER_SCHEDULE_HPP_
@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_OP_COUNTERS_HPP_
+#define VIPER25519_OP_COUNTERS_HPP_
+
+#include <cstdint>
+
+namespace ed25519
+{
+
+/// @brief Numbers of field and group operations performed.
+/// Composite operations also count their parts: an inversion adds one to
+/// field_invert as well as the squares and multiplications it consists of,
+/// and a point doubling that returns extended coordinates counts one
+/// doubling and one conversion.
+struct OpCounts
+{
+    uint64_t field_mul = 0;
+    uint64_t field_square = 0;
+    uint64_t field_invert = 0;
+    uint64_t field_expand = 0;
+    uint64_t field_contract = 0;
+    uint64_t point_add = 0;
+    uint64_t point_double = 0;
+    uint64_t point_convert = 0;
+
+    /// @brief Return the counts accumulated since an earlier snapshot.
+    [[nodiscard]] constexpr auto operator-(const OpCounts& rhs) const noexcept
+        -> OpCounts
+    {
+        return {
+            this->field_mul - rhs.field_mul,
+            this->field_square - rhs.field_square,
+            this->field_invert - rhs.field_invert,
+            this->field_expand - rhs.field_expand,
+            this->field_contract - rhs.field_contract,
+            this->point_add - rhs.point_add,
+            this->point_double - rhs.point_double,
+            this->point_convert - rhs.point_convert
+        };
+    }
+
+    constexpr auto operator==(const OpCounts&) const -> bool = default;
+};
+
+/// @brief Per-thread counts of field and group operations.
+/// The counters are only maintained when the library is built with
+/// VIPER25519_OPCOUNT, otherwise every snapshot is zero. They are meant for
+/// tests and analysis builds where the cost of an algorithm should be
+/// asserted exactly, e.g. that a code path performs a single inversion.
+class OpCounters
+{
+  public:
+    /// @brief Return true if the library was built with VIPER25519_OPCOUNT.
+    [[nodiscard]] static auto enabled() noexcept -> bool;
+
+    /// @brief Return the counts of the calling thread.
+    [[nodiscard]] static auto snapshot() noexcept -> OpCounts;
+
+    /// @brief Set the counts of the calling thread to zero.
+    static auto reset() noexcept -> void;
+
+};  // OpCounters
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_OP_COUNTERS_HPP_
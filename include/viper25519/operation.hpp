@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_OPERATION_HPP_
+#define VIPER25519_OPERATION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ed25519
+{
+
+/// @brief Library operations that can be instrumented.
+enum class Operation : uint8_t
+{
+    /// Ed25519 signing (all variants).
+    Sign,
+    /// Ed25519 signature verification (all variants).
+    Verify,
+    /// Fixed-base scalar multiplication [s]B.
+    BasepointMul,
+    /// Double scalar multiplication [s1]P + [s2]B.
+    DoubleScalarMul,
+    /// Point decoding.
+    Unpack,
+    /// VRF proof construction.
+    VrfProve,
+    /// VRF proof verification.
+    VrfVerify,
+    /// Derivation of a public key from a private key.
+    KeyDerive
+};
+
+/// Number of values in the Operation enumeration.
+constexpr size_t OPERATION_COUNT = 8;
+
+/// @brief Return a short lower case name for an operation.
+[[nodiscard]] constexpr auto operationName(Operation op) noexcept
+    -> std::string_view
+{
+    switch (op)
+    {
+        case Operation::Sign:
+            return "sign";
+        case Operation::Verify:
+            return "verify";
+        case Operation::BasepointMul:
+            return "basepoint_mul";
+        case Operation::DoubleScalarMul:
+            return "double_scalar_mul";
+        case Operation::Unpack:
+            return "unpack";
+        case Operation::VrfProve:
+            return "vrf_prove";
+        case Operation::VrfVerify:
+            return "vrf_verify";
+        case Operation::KeyDerive:
+            return "key_derive";
+    }
+    return "unknown";
+}  // operationName
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_OPERATION_HPP_
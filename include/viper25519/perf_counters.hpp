@@ -0,0 +1,100 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_PERF_COUNTERS_HPP_
+#define VIPER25519_PERF_COUNTERS_HPP_
+
+#include <array>
+#include <cstdint>
+
+#include <viper25519/operation.hpp>
+
+namespace ed25519
+{
+
+/// @brief Hardware counter totals of one operation.
+struct PerfCounterStats
+{
+    uint64_t calls = 0;
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t branch_misses = 0;
+    uint64_t l1d_misses = 0;
+
+    /// @brief Return instructions per cycle, or zero without samples.
+    [[nodiscard]] constexpr auto ipc() const noexcept -> double
+    {
+        if (this->cycles == 0) return 0.0;
+        return static_cast<double>(this->instructions) /
+               static_cast<double>(this->cycles);
+    }
+};
+
+/// @brief Process-wide hardware performance counters per operation.
+/// When the library is built with VIPER25519_PERF_COUNTERS, the operations
+/// listed in Operation read the CPU cycle, instruction, branch miss and L1
+/// data cache miss counters of the calling thread through perf_event_open
+/// and add the differences to per-operation totals. Counting is inclusive,
+/// so a verification also appears under DoubleScalarMul and Unpack. Without
+/// the build option, or where the kernel refuses access to the counters,
+/// nothing is recorded. Collection is off until enabled.
+class PerfCounters
+{
+  public:
+    /// @brief Return true if instrumentation is compiled in and the counters
+    /// can be opened on the calling thread.
+    [[nodiscard]] static auto available() noexcept -> bool;
+
+    /// @brief Start or stop collecting counters.
+    static auto setEnabled(bool enabled) noexcept -> void;
+
+    /// @brief Return true if counters are being collected.
+    [[nodiscard]] static auto enabled() noexcept -> bool;
+
+    /// @brief Return the totals of one operation.
+    /// Counters the processor does not provide are reported as zero.
+    [[nodiscard]] static auto stats(Operation op) noexcept -> PerfCounterStats;
+
+    /// @brief Set all totals back to zero.
+    static auto reset() noexcept -> void;
+
+};  // PerfCounters
+
+/// @brief Add the counter differences over its lifetime to an operation.
+/// Used by the library's instrumentation hooks.
+class PerfScope
+{
+  private:
+    std::array<uint64_t, 4> start_{};
+    Operation op_;
+    bool active_ = false;
+
+  public:
+    explicit PerfScope(Operation op) noexcept;
+    ~PerfScope();
+
+    PerfScope(const PerfScope&) = delete;
+    auto operator=(const PerfScope&) -> PerfScope& = delete;
+
+};  // PerfScope
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_PERF_COUNTERS_HPP_
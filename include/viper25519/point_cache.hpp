@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_POINT_CACHE_HPP_
+#define VIPER25519_POINT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+#include <viper25519/curve25519.hpp>
+
+namespace ed25519
+{
+
+/// @brief Order in which full cache shards discard entries.
+enum class EvictionPolicy : uint8_t
+{
+    /// Discard the entry that was used least recently.
+    Lru,
+    /// Discard the entry that was inserted first.
+    Fifo
+};
+
+/// @brief Counters describing the use of the point cache.
+struct PointCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t size = 0;
+};
+
+/// @brief Process-wide cache of decoded public keys.
+/// Verification decodes the 32 byte public key into a curve point, which
+/// costs a field square root. When the same keys are verified repeatedly the
+/// decoded points may be kept in this cache instead. The cache is split into
+/// independently locked shards so that concurrent verifiers rarely contend.
+/// It is disabled (capacity zero) until configured.
+class PointCache
+{
+  public:
+    /// Number of independently locked shards.
+    static constexpr size_t SHARD_COUNT = 16;
+
+    /// @brief Set the total number of cached keys and the eviction policy.
+    /// The capacity is divided evenly between the shards, rounding up. Any
+    /// cached entries and counters are discarded. A capacity of zero disables
+    /// the cache.
+    static auto configure(
+        size_t capacity, EvictionPolicy policy = EvictionPolicy::Lru
+    ) -> void;
+
+    /// @brief Return true if the cache has a non-zero capacity.
+    [[nodiscard]] static auto enabled() noexcept -> bool;
+
+    /// @brief Remove all cached entries, keeping the configuration.
+    static auto clear() -> void;
+
+    /// @brief Return the hit and miss counters and the number of entries.
+    [[nodiscard]] static auto stats() -> PointCacheStats;
+
+    /// @brief Reset the hit and miss counters.
+    static auto resetStats() noexcept -> void;
+
+    /// @brief Decode a public key through the cache.
+    /// Equivalent to curve25519::ExtendedPoint::tryUnpack (the negated point
+    /// is returned) but served from the cache when enabled. Keys that fail to
+    /// decode are not cached.
+    [[nodiscard]] static auto unpack(std::span<const uint8_t, 32> key) noexcept
+        -> std::optional<curve25519::ExtendedPoint>;
+
+};  // PointCache
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_POINT_CACHE_HPP_
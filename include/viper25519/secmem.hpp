@@ -21,16 +21,56 @@
 #ifndef VIPER25519_SECMEM_HPP_
 #define VIPER25519_SECMEM_HPP_
 
-#include <sys/mman.h>
-
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
 
 namespace ed25519
 {
 
+/// @brief Process-wide pool of locked memory for secret key material.
+/// The arena is made of mlocked regions surrounded by guard pages and excluded
+/// from core dumps. Each region is divided into fixed size slots that are
+/// handed out by a lock-free allocator, so creating and destroying key objects
+/// does not require any system calls. When all of the existing regions are
+/// full a new one, twice the size of the last, is added, so the arena keeps
+/// up with any number of keys in a handful of regions. Requests larger than a
+/// slot, or made once no further region can be mapped, fall back to
+/// individually locked heap memory.
+class SecureArena
+{
+  public:
+    /// Size in bytes of a single arena slot.
+    static constexpr size_t SLOT_SIZE = 64;
+
+    /// Number of slots in the first arena region. Each further region has
+    /// twice as many slots as the one before it.
+    static constexpr size_t SLOT_COUNT = 1024;
+
+    /// Maximum number of regions the arena grows to, which together hold
+    /// SLOT_COUNT * (2^MAX_REGIONS - 1) slots.
+    static constexpr size_t MAX_REGIONS = 32;
+
+    /// @brief Allocate zeroed secure memory of the given size.
+    [[nodiscard]] static auto allocate(size_t size) -> void*;
+
+    /// @brief Wipe and release memory obtained from allocate.
+    static auto deallocate(void* p, size_t size) -> void;
+
+    /// @brief Return the number of arena slots currently in use.
+    [[nodiscard]] static auto slotsInUse() -> size_t;
+
+};  // SecureArena
+
+/// @brief Fixed size byte array stored in secure memory.
+/// The bytes live in the SecureArena rather than within the object itself and
+/// are wiped when the object is destroyed. The interface mirrors the parts of
+/// std::array used throughout the library.
 template <class T, std::size_t Size>
-struct SecureByteArray : public std::array<T, Size>
+class SecureByteArray
 {
     static_assert(
         std::is_standard_layout<T>::value && std::is_trivial<T>::value,
@@ -38,19 +78,87 @@ struct SecureByteArray : public std::array<T, Size>
     );
     static_assert(sizeof(T) == 1, "Only 1-byte types allowed");
 
+  private:
+    T* data_;
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T*;
+    using const_iterator = const T*;
+
     SecureByteArray()
+        : data_{static_cast<T*>(SecureArena::allocate(sizeof(T) * Size))}
     {
-        mlock(std::array<T, Size>::data(), sizeof(T) * Size);
+    }
+
+    SecureByteArray(const SecureByteArray& other) : SecureByteArray()
+    {
+        std::copy_n(other.data_, Size, this->data_);
+    }
+
+    auto operator=(const SecureByteArray& other) -> SecureByteArray&
+    {
+        if (this != &other) std::copy_n(other.data_, Size, this->data_);
+        return *this;
     }
 
     ~SecureByteArray()
     {
-        char *bytes = reinterpret_cast<char *>(std::array<T, Size>::data());
-        std::fill_n<volatile char *>(bytes, sizeof(T) * Size, 0);
-        munlock(bytes, sizeof(T) * Size);
+        SecureArena::deallocate(this->data_, sizeof(T) * Size);
+    }
+
+    [[nodiscard]] auto data() -> T* { return this->data_; }
+    [[nodiscard]] auto data() const -> const T* { return this->data_; }
+
+    [[nodiscard]] static constexpr auto size() -> size_type { return Size; }
+
+    [[nodiscard]] auto begin() -> iterator { return this->data_; }
+    [[nodiscard]] auto begin() const -> const_iterator { return this->data_; }
+    [[nodiscard]] auto end() -> iterator { return this->data_ + Size; }
+    [[nodiscard]] auto end() const -> const_iterator
+    {
+        return this->data_ + Size;
+    }
+
+    auto operator[](size_type i) -> T& { return this->data_[i]; }
+    auto operator[](size_type i) const -> const T& { return this->data_[i]; }
+
+    operator std::span<T, Size>()
+    {
+        return std::span<T, Size>(this->data_, Size);
+    }
+
+    operator std::span<const T, Size>() const
+    {
+        return std::span<const T, Size>(this->data_, Size);
+    }
+
+    friend auto operator==(
+        const SecureByteArray& lhs, const SecureByteArray& rhs
+    ) -> bool
+    {
+        return SecureByteArray::equal(lhs.data_, rhs.data());
+    }
+
+    friend auto operator==(
+        const SecureByteArray& lhs, const std::array<T, Size>& rhs
+    ) -> bool
+    {
+        return SecureByteArray::equal(lhs.data_, rhs.data());
+    }
+
+  private:
+    /// Timing safe comparison of two arrays of the same size.
+    static auto equal(const T* x, const T* y) -> bool
+    {
+        auto diff = 0U;
+        for (size_type i = 0; i < Size; ++i)
+            diff |= static_cast<unsigned int>(x[i] ^ y[i]);
+        return diff == 0;
     }
-}; // SecureByteArray
+};  // SecureByteArray
 
 }  // namespace ed25519
 
-#endif  // VIPER25519_SECMEM_HPP_
\ No newline at end of file
+#endif  // VIPER25519_SECMEM_HPP_
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_SIGNATURE_CACHE_HPP_
+#define VIPER25519_SIGNATURE_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <viper25519/ed25519.hpp>
+
+namespace ed25519
+{
+
+/// @brief Counters describing the use of the signature cache.
+struct SignatureCacheStats
+{
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    size_t capacity = 0;
+};
+
+/// @brief Process-wide cache of successfully verified signatures.
+/// Entries are 128 bit fingerprints of the signature, public key, message and
+/// verification mode, computed with a random per-table salt so that they can
+/// not be predicted from outside the process. The fingerprints are stored in
+/// a fixed size open addressing table that is read and written with atomic
+/// operations only, so lookups never block. Only valid results are cached; a
+/// lost or evicted entry simply causes the signature to be checked again.
+///
+/// Fingerprints are derived from H(R,A,M), which verification computes
+/// anyway, so a hit skips all of the curve arithmetic. The cache is disabled
+/// until configured.
+class SignatureCache
+{
+  public:
+    /// Size in bytes of a single table entry.
+    static constexpr size_t ENTRY_SIZE = 16;
+
+    /// @brief Allocate a table within the given memory budget.
+    /// The number of entries is the largest power of two that fits in the
+    /// budget. Any existing entries and counters are discarded. A budget of
+    /// zero disables the cache.
+    static auto configure(size_t bytes) -> void;
+
+    /// @brief Return true if a table is allocated.
+    [[nodiscard]] static auto enabled() noexcept -> bool;
+
+    /// @brief Remove all entries, keeping the table.
+    static auto clear() noexcept -> void;
+
+    /// @brief Return the hit and miss counters and the number of entries.
+    [[nodiscard]] static auto stats() noexcept -> SignatureCacheStats;
+
+    /// @brief Reset the hit and miss counters.
+    static auto resetStats() noexcept -> void;
+
+    /// @brief Test whether a signature was previously recorded as valid.
+    /// @param hram The 64 byte hash H(R,A,M) of the signature being checked.
+    /// @param s The scalar S (second half) of the signature.
+    /// @param mode The rules the signature is being checked under.
+    [[nodiscard]] static auto contains(
+        std::span<const uint8_t, 64> hram,
+        std::span<const uint8_t, 32> s,
+        VerifyMode mode
+    ) noexcept -> bool;
+
+    /// @brief Record a signature that was verified as valid.
+    static auto insert(
+        std::span<const uint8_t, 64> hram,
+        std::span<const uint8_t, 32> s,
+        VerifyMode mode
+    ) noexcept -> void;
+
+};  // SignatureCache
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_SIGNATURE_CACHE_HPP_
@@ -0,0 +1,73 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_THREAD_POOL_HPP_
+#define VIPER25519_THREAD_POOL_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ed25519
+{
+
+/// @brief Fixed size pool of worker threads with work stealing.
+/// Every worker owns a task queue. Tasks submitted from a worker go to its own
+/// queue and are run newest first, while idle workers steal the oldest tasks
+/// from the other queues. Tasks submitted from outside the pool are spread
+/// over the queues in turn.
+class ThreadPool
+{
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+  public:
+    /// @brief Start the worker threads.
+    /// @param threads The number of workers, zero selects the number of
+    /// hardware threads.
+    explicit ThreadPool(size_t threads = 0);
+
+    /// @brief Finish all queued tasks and join the workers.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    auto operator=(const ThreadPool&) -> ThreadPool& = delete;
+
+    /// @brief Return the number of worker threads.
+    [[nodiscard]] auto size() const noexcept -> size_t;
+
+    /// @brief Queue a task to run on one of the workers.
+    /// As with std::thread, an exception escaping the task terminates the
+    /// program.
+    auto submit(std::function<void()> task) -> void;
+
+    /// @brief Run fn(0), ..., fn(count - 1) on the pool and wait for them.
+    /// The calling thread runs queued tasks while it waits, so this may also
+    /// be called from within a task. The first exception thrown by fn is
+    /// rethrown once all calls have finished.
+    auto parallelFor(size_t count, const std::function<void(size_t)>& fn)
+        -> void;
+
+};  // ThreadPool
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_THREAD_POOL_HPP_
@@ -0,0 +1,151 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_VERIFICATION_SERVICE_HPP_
+#define VIPER25519_VERIFICATION_SERVICE_HPP_
+
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <viper25519/ed25519.hpp>
+#include <viper25519/thread_pool.hpp>
+
+namespace ed25519
+{
+
+/// @brief Batching thresholds and rules of a VerificationService.
+struct VerificationOptions
+{
+    /// Dispatch as soon as this many signatures are queued.
+    size_t maxBatch = 64;
+    /// Dispatch once the oldest queued signature has waited this long.
+    std::chrono::microseconds maxDelay{500};
+    /// The rules the signatures are checked under.
+    VerifyMode mode = VerifyMode::Zip215;
+};
+
+/// @brief Asynchronous front end that batches individual verifications.
+/// Submissions are queued and handed to a BatchVerifier once either
+/// maxBatch signatures are waiting or the oldest has waited for maxDelay.
+/// Callers either co_await submit from a coroutine or wait on the future
+/// returned by submitFuture. Completions run on a thread of the pool, so a
+/// coroutine awaiting submit resumes there. Completions must not throw; an
+/// exception escaping one is discarded. Once the destructor has started,
+/// including from a completion it is waiting for, submissions throw
+/// std::logic_error.
+class VerificationService
+{
+  public:
+    using Options = VerificationOptions;
+
+    /// Completion callback receiving either an error or the result.
+    using Completion = std::function<void(std::exception_ptr, bool)>;
+
+    /// @brief Awaitable returned by submit, resuming with the result.
+    class Awaitable
+    {
+      private:
+        VerificationService* service_;
+        PublicKey key_;
+        std::vector<uint8_t> msg_;
+        std::array<uint8_t, ED25519_SIGNATURE_SIZE> sig_;
+        std::exception_ptr error_;
+        bool result_ = false;
+
+      public:
+        Awaitable(
+            VerificationService& service,
+            const PublicKey& key,
+            std::span<const uint8_t> msg,
+            std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+        );
+
+        [[nodiscard]] auto await_ready() const noexcept -> bool
+        {
+            return false;
+        }
+        auto await_suspend(std::coroutine_handle<> handle) -> void;
+        auto await_resume() -> bool;
+    };
+
+    /// @brief Start a service that runs on its own thread pool.
+    explicit VerificationService(Options options = {});
+
+    /// @brief Start a service that runs on the given thread pool.
+    /// @param pool A pool that outlives the service.
+    explicit VerificationService(ThreadPool& pool, Options options = {});
+
+    /// @brief Dispatch the remaining submissions and wait for them.
+    ~VerificationService();
+
+    VerificationService(const VerificationService&) = delete;
+    auto operator=(const VerificationService&)
+        -> VerificationService& = delete;
+
+    /// @brief Submit a signature, for use with co_await.
+    /// The message is copied so it need not outlive the call.
+    [[nodiscard]] auto submit(
+        const PublicKey& key,
+        std::span<const uint8_t> msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+    ) -> Awaitable;
+
+    /// @brief Submit a signature and return a future for the result.
+    /// The message is copied so it need not outlive the call.
+    [[nodiscard]] auto submitFuture(
+        const PublicKey& key,
+        std::span<const uint8_t> msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+    ) -> std::future<bool>;
+
+    /// @brief Submit a signature with a completion callback.
+    /// The message is copied so it need not outlive the call.
+    auto submitCallback(
+        const PublicKey& key,
+        std::span<const uint8_t> msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        Completion done
+    ) -> void;
+
+  private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+    auto enqueue(
+        const PublicKey& key,
+        std::vector<uint8_t>&& msg,
+        std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+        Completion&& done
+    ) -> void;
+
+};  // VerificationService
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_VERIFICATION_SERVICE_HPP_
@@ -24,9 +24,13 @@
 // Standard Library Headers
 #include <array>
 #include <cstdint>
+#include <optional>
 #include <span>
+#include <utility>
+#include <vector>
 
 // Viper25519 Headers
+#include <viper25519/curve25519.hpp>
 #include <viper25519/ed25519.hpp>
 
 namespace ed25519
@@ -37,6 +41,17 @@ static constexpr size_t ED25519_VRF_PUBLIC_KEY_SIZE = 32;
 static constexpr size_t ED25519_VRF_SECRET_KEY_SIZE = 64;
 static constexpr size_t ED25519_VRF_PROOF_SIZE = 80;
 static constexpr size_t ED25519_VRF_PROOF_HASH_SIZE = 64;
+static constexpr size_t ED25519_VRF_BATCH_PROOF_SIZE = 128;
+
+/// @brief The ECVRF-EDWARDS25519-SHA512-ELL2 variant used for proofs.
+/// Both produce 80 byte proofs and 64 byte hashes but are not compatible.
+enum class VRFSuite : uint8_t
+{
+    /// draft-irtf-cfrg-vrf-03, as used by Cardano and the libsodium forks.
+    IetfDraft03,
+    /// RFC 9381, hashing to the curve as specified by RFC 9380.
+    Rfc9381
+};
 
 /// @brief Represent a VRF key as a secure byte array.
 using VRFKeyByteArray = SecureByteArray<uint8_t, ED25519_VRF_SECRET_KEY_SIZE>;
@@ -62,10 +77,59 @@ class VRFPublicKey : public ed25519::PublicKey
     /// @brief Verify a VRF proof from the associated secret key.
     /// @param msg The message from which the proof and hash were derived.
     /// @param proof The proof to verify.
+    /// @param suite The VRF variant the proof was constructed with.
     /// @return True if the proof is valid, false otherwise.
     [[nodiscard]] auto verifyProof(
-        std::span<const uint8_t> msg, std::span<const uint8_t> proof
+        std::span<const uint8_t> msg, std::span<const uint8_t> proof,
+        VRFSuite suite = VRFSuite::IetfDraft03
+    ) const -> bool;
+
+    /// @brief Verify a VRF proof and return its hash.
+    ///
+    /// Equivalent to verifyProof followed by proofToHash, but the proof is
+    /// only decoded once and [8]Gamma is encoded together with the challenge
+    /// points.
+    /// @param msg The message from which the proof and hash were derived.
+    /// @param proof The proof to verify.
+    /// @param suite The VRF variant the proof was constructed with.
+    /// @return The VRF hash if the proof is valid, std::nullopt otherwise.
+    [[nodiscard]] auto verifyProofAndHash(
+        std::span<const uint8_t> msg, std::span<const uint8_t> proof,
+        VRFSuite suite = VRFSuite::IetfDraft03
+    ) const -> std::optional<std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>;
+
+    /// @brief Verify a batch compatible VRF proof from the associated secret
+    /// key.
+    ///
+    /// The check is cofactored and accepts the same proofs as
+    /// verifyProofBatch.
+    /// @param msg The message from which the proof and hash were derived.
+    /// @param proof The 128 byte proof (Gamma || U || V || s) to verify.
+    /// @return True if the proof is valid, false otherwise.
+    [[nodiscard]] auto verifyBatchCompatibleProof(
+        std::span<const uint8_t> msg,
+        std::span<const uint8_t, ED25519_VRF_BATCH_PROOF_SIZE> proof
     ) const -> bool;
+
+    /// @brief Verify many batch compatible VRF proofs at once.
+    ///
+    /// The proofs are combined with random weights into a single
+    /// multi-scalar multiplication. The check is cofactored, so it may
+    /// accept a proof that only differs from a valid one by a small order
+    /// component; such a proof hashes to the same output and is accepted by
+    /// verifyBatchCompatibleProof too. Use verifyBatchCompatibleProof to find
+    /// the offending proof when the batch fails.
+    /// @param keys The public keys, one per proof.
+    /// @param msgs The messages, one per proof.
+    /// @param proofs The batch compatible proofs.
+    /// @return True if every proof is valid (or the batch is empty).
+    /// @throws std::invalid_argument if the span sizes differ.
+    [[nodiscard]] static auto verifyProofBatch(
+        std::span<const VRFPublicKey> keys,
+        std::span<const std::span<const uint8_t>> msgs,
+        std::span<const std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>>
+            proofs
+    ) -> bool;
 };
 
 /// @brief Represents a VRF secret key.
@@ -120,30 +184,165 @@ class VRFSecretKey
 
     /// @brief Construct a VRF proof from an initial message.
     /// @param msg A span of bytes (uint8_t) representing the message.
+    /// @param suite The VRF variant to construct the proof with.
     /// @return A vector of bytes representing the VRF proof.
-    [[nodiscard]] auto constructProof(std::span<const uint8_t> msg)
-        -> std::array<uint8_t, ED25519_VRF_PROOF_SIZE>;
+    [[nodiscard]] auto constructProof(
+        std::span<const uint8_t> msg, VRFSuite suite = VRFSuite::IetfDraft03
+    ) -> std::array<uint8_t, ED25519_VRF_PROOF_SIZE>;
+
+    /// @brief Construct a batch compatible VRF proof from an initial message.
+    ///
+    /// The proof follows the RFC 9381 suite but carries the commitments U and
+    /// V in place of the challenge (Gamma || U || V || s, as in the batchable
+    /// variant of draft-irtf-cfrg-vrf-13). Its hash equals that of the RFC
+    /// 9381 proof of the same message.
+    /// @param msg A span of bytes (uint8_t) representing the message.
+    /// @return The 128 byte proof.
+    [[nodiscard]] auto constructBatchCompatibleProof(
+        std::span<const uint8_t> msg
+    ) const -> std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>;
 
     /// @brief Convert a VRF proof to a VRF hash.
+    /// Throws if the proof cannot be decoded.
     /// @param proof The VRF proof.
+    /// @param suite The VRF variant the proof was constructed with.
     /// @return The VRF hash.
     [[nodiscard]] static auto proofToHash(
-        std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof
+        std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof,
+        VRFSuite suite = VRFSuite::IetfDraft03
+    ) -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>;
+
+    /// @brief Convert a batch compatible VRF proof to a VRF hash.
+    /// Throws if the proof cannot be decoded.
+    /// @param proof The 128 byte VRF proof.
+    /// @return The VRF hash.
+    [[nodiscard]] static auto batchCompatibleProofToHash(
+        std::span<const uint8_t, ED25519_VRF_BATCH_PROOF_SIZE> proof
     ) -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>;
 
     /// @brief Compute the VRF hash of a message.
     /// @param msg The message to hash.
+    /// @param suite The VRF variant to use.
     /// @return The VRF hash.
-    [[nodiscard]] auto hash(std::span<const uint8_t> msg)
-        -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>;
+    [[nodiscard]] auto hash(
+        std::span<const uint8_t> msg, VRFSuite suite = VRFSuite::IetfDraft03
+    ) -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>;
 
     /// @brief Verify a VRF proof from the associated secret key.
     /// @param msg The message from which the proof and hash were derived.
     /// @param proof The proof to verify.
+    /// @param suite The VRF variant the proof was constructed with.
     /// @return True if the proof is valid, false otherwise.
     [[nodiscard]] auto verifyProof(
         std::span<const uint8_t> msg,
-        std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof
+        std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof,
+        VRFSuite suite = VRFSuite::IetfDraft03
+    ) const -> bool;
+};
+
+/// @brief A VRF secret key prepared for repeated proving.
+///
+/// VRFSecretKey stores the seed and re-derives the secret scalar with SHA-512
+/// for every proof. This class does so once on construction, where it also
+/// checks the key as isValid does, and keeps the expanded scalar and the
+/// nonce prefix. The decoded public point is kept as well so that verifyProof
+/// does not decode the key again; proving does not use it. Proofs are
+/// identical to those of the key it was prepared from. Use it when many
+/// proofs are made with one key, e.g. one per slot.
+class PreparedVRFSecretKey
+{
+  private:
+    /// Clamped secret scalar followed by the nonce prefix.
+    ExtKeyByteArray az_{};
+
+    /// The public key and its decoded (negated) point, used by verifyProof.
+    VRFPublicKey pk_;
+    curve25519::ExtendedPoint y_neg_{};
+
+  public:
+    /// @brief Expand and check a VRF secret key.
+    /// @param key The key to prepare.
+    /// @throws std::invalid_argument if the public key half of the key does
+    /// not match its seed.
+    explicit PreparedVRFSecretKey(VRFSecretKey const& key);
+
+    /// @brief Return the public key paired with this private key.
+    [[nodiscard]] constexpr auto publicKey() const -> const VRFPublicKey&
+    {
+        return this->pk_;
+    }
+
+    /// @brief Construct a VRF proof from an initial message.
+    /// @param msg A span of bytes (uint8_t) representing the message.
+    /// @param suite The VRF variant to construct the proof with.
+    /// @return The 80 byte proof.
+    [[nodiscard]] auto constructProof(
+        std::span<const uint8_t> msg, VRFSuite suite = VRFSuite::IetfDraft03
+    ) const -> std::array<uint8_t, ED25519_VRF_PROOF_SIZE>;
+
+    /// @brief Construct a VRF proof and its hash together.
+    /// The hash is taken from Gamma as it is computed, so the proof does not
+    /// need to be decoded again as proofToHash would.
+    /// @param msg A span of bytes (uint8_t) representing the message.
+    /// @param suite The VRF variant to construct the proof with.
+    /// @return The 80 byte proof and the 64 byte hash.
+    [[nodiscard]] auto constructProofAndHash(
+        std::span<const uint8_t> msg, VRFSuite suite = VRFSuite::IetfDraft03
+    ) const
+        -> std::pair<
+            std::array<uint8_t, ED25519_VRF_PROOF_SIZE>,
+            std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>;
+
+    /// @brief Construct the proofs and hashes of several messages.
+    /// The results are identical to calling constructProofAndHash for each
+    /// message, but the points of all proofs are encoded with two field
+    /// inversions in total.
+    /// @param msgs The messages to prove.
+    /// @param suite The VRF variant to construct the proofs with.
+    /// @return The proof and hash of each message, in order.
+    [[nodiscard]] auto constructProofAndHashBatch(
+        std::span<const std::span<const uint8_t>> msgs,
+        VRFSuite suite = VRFSuite::IetfDraft03
+    ) const
+        -> std::vector<std::pair<
+            std::array<uint8_t, ED25519_VRF_PROOF_SIZE>,
+            std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>>;
+
+    /// @brief Construct a batch compatible VRF proof from an initial message.
+    /// @param msg A span of bytes (uint8_t) representing the message.
+    /// @return The 128 byte proof.
+    [[nodiscard]] auto constructBatchCompatibleProof(
+        std::span<const uint8_t> msg
+    ) const -> std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>;
+
+    /// @brief Compute the VRF hash of a message.
+    /// Only Gamma is computed, so this costs a fraction of a proof.
+    /// @param msg The message to hash.
+    /// @param suite The VRF variant to use.
+    /// @return The VRF hash.
+    [[nodiscard]] auto hash(
+        std::span<const uint8_t> msg, VRFSuite suite = VRFSuite::IetfDraft03
+    ) const -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>;
+
+    /// @brief Compute the VRF hashes of several messages.
+    /// The results are identical to calling hash for each message, but the
+    /// points of all messages are encoded with one field inversion.
+    /// @param msgs The messages to hash.
+    /// @param suite The VRF variant to use.
+    /// @return The hash of each message, in order.
+    [[nodiscard]] auto hashBatch(
+        std::span<const std::span<const uint8_t>> msgs,
+        VRFSuite suite = VRFSuite::IetfDraft03
+    ) const -> std::vector<std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>;
+
+    /// @brief Verify a VRF proof using the cached public point.
+    /// @param msg The message from which the proof and hash were derived.
+    /// @param proof The proof to verify.
+    /// @param suite The VRF variant the proof was constructed with.
+    /// @return True if the proof is valid, false otherwise.
+    [[nodiscard]] auto verifyProof(
+        std::span<const uint8_t> msg, std::span<const uint8_t> proof,
+        VRFSuite suite = VRFSuite::IetfDraft03
     ) const -> bool;
 };
 
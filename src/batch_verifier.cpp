@@ -0,0 +1,215 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// Third-Party Library Headers
+#include <botan/hash.h>
+
+// Public Viper25519 Headers
+#include <viper25519/batch_verifier.hpp>
+#include <viper25519/curve25519.hpp>
+#include <viper25519/point_cache.hpp>
+#include <viper25519/signature_cache.hpp>
+
+// Private Viper25519 code
+#include "random.hpp"
+#include "utils.hpp"
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+/// A signature decoded for the batch equation.
+struct Prepared
+{
+    size_t index;
+    std::array<uint8_t, 64> hram;
+    curve25519::bignum25519 s;
+    curve25519::ExtendedPoint neg_a;
+    curve25519::ExtendedPoint neg_r;
+};
+
+}  // unnamed namespace
+
+BatchVerifier::BatchVerifier(VerifyMode mode) : mode_{mode} {}
+
+BatchVerifier::BatchVerifier(ThreadPool& pool, VerifyMode mode)
+    : mode_{mode}, pool_{&pool}
+{
+}
+
+auto BatchVerifier::add(
+    const PublicKey& key,
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+) -> void
+{
+    auto item = Item{key, msg, {}};
+    std::copy(sig.begin(), sig.end(), item.sig.begin());
+    this->items_.push_back(std::move(item));
+}  // BatchVerifier::add
+
+auto BatchVerifier::size() const noexcept -> size_t
+{
+    return this->items_.size();
+}  // BatchVerifier::size
+
+auto BatchVerifier::clear() noexcept -> void
+{
+    this->items_.clear();
+}  // BatchVerifier::clear
+
+auto BatchVerifier::verify() -> std::vector<bool>
+{
+    const auto n = this->items_.size();
+    auto results = std::vector<uint8_t>(n, 0);
+    if (n == 0) return {};
+
+    if (!this->pool_)
+    {
+        this->owned_pool_ = std::make_unique<ThreadPool>();
+        this->pool_ = this->owned_pool_.get();
+    }
+
+    const auto chunks = (n + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    this->pool_->parallelFor(
+        chunks,
+        [&](size_t c)
+        {
+            const auto first = c * CHUNK_SIZE;
+            this->verifyChunk(
+                first, std::min(first + CHUNK_SIZE, n), results
+            );
+        }
+    );
+
+    return std::vector<bool>(results.begin(), results.end());
+}  // BatchVerifier::verify
+
+auto BatchVerifier::verifyChunk(
+    size_t first, size_t last, std::span<uint8_t> results
+) const -> void
+{
+    if (this->mode_ != VerifyMode::Zip215)
+    {
+        for (auto i = first; i < last; ++i)
+        {
+            const auto& item = this->items_[i];
+            results[i] = item.key.tryVerifySignature(
+                             item.msg, item.sig, this->mode_
+                         ) == VerifyResult::Valid;
+        }
+        return;
+    }
+
+    // Decode every signature, dropping the malformed ones and those already
+    // in the signature cache.
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    auto batch = std::vector<Prepared>();
+    batch.reserve(last - first);
+    for (auto i = first; i < last; ++i)
+    {
+        const auto& item = this->items_[i];
+        const auto sig = std::span<const uint8_t, 64>(item.sig);
+        const auto sig_r = sig.first<32>();
+        const auto sig_s = sig.last<32>();
+        if (!is_canonical_scalar(sig_s)) continue;
+
+        auto prepared = Prepared{};
+        prepared.index = i;
+        sha512->update(sig_r.data(), sig_r.size());
+        sha512->update(item.key.bytes().data(), ED25519_KEY_SIZE);
+        sha512->update(item.msg.data(), item.msg.size());
+        sha512->final(prepared.hram.data());
+        if (SignatureCache::contains(prepared.hram, sig_s, this->mode_))
+        {
+            results[i] = 1;
+            continue;
+        }
+
+        const auto neg_a = PointCache::unpack(item.key.bytes());
+        const auto neg_r = curve25519::ExtendedPoint::tryUnpack(sig_r);
+        if (!neg_a || !neg_r) continue;
+        prepared.s = curve25519::bignum25519::expand256_modm(sig_s);
+        prepared.neg_a = *neg_a;
+        prepared.neg_r = *neg_r;
+        batch.push_back(prepared);
+    }
+    if (batch.empty()) return;
+
+    // With random 128 bit z_i check that
+    //   [8]([sum z_i s_i]B + sum [z_i](-R_i) + sum [z_i h_i](-A_i))
+    // is the identity. Unpacking already provides the negated points.
+    auto z_bytes = std::vector<uint8_t>(16 * batch.size());
+    ChaCha20Rng::local().randomize(z_bytes);
+
+    auto scalars = std::vector<curve25519::bignum25519>();
+    auto points = std::vector<curve25519::ExtendedPoint>();
+    scalars.reserve(2 * batch.size());
+    points.reserve(2 * batch.size());
+    auto sum = curve25519::bignum25519{};
+    for (size_t k = 0; k < batch.size(); ++k)
+    {
+        auto z_raw = std::array<uint8_t, 32>{};
+        std::copy_n(
+            z_bytes.begin() + 16 * static_cast<ptrdiff_t>(k), 16, z_raw.begin()
+        );
+        const auto z = curve25519::bignum25519::expand256_modm(z_raw);
+        const auto h = curve25519::bignum25519::expand256_modm(batch[k].hram);
+
+        sum = curve25519::bignum25519::add256_modm(
+            sum, curve25519::bignum25519::mul256_modm(z, batch[k].s)
+        );
+        scalars.push_back(z);
+        points.push_back(batch[k].neg_r);
+        scalars.push_back(curve25519::bignum25519::mul256_modm(z, h));
+        points.push_back(batch[k].neg_a);
+    }
+
+    const auto lhs = curve25519::ExtendedPoint::multiplyBasepointByScalar(sum);
+    const auto rhs =
+        curve25519::ExtendedPoint::multiScalarMultiple(scalars, points);
+    if ((lhs.mulByCofactor() + rhs.mulByCofactor()).isIdentity())
+    {
+        for (const auto& prepared : batch)
+        {
+            results[prepared.index] = 1;
+            const auto sig = std::span<const uint8_t, 64>(
+                this->items_[prepared.index].sig
+            );
+            SignatureCache::insert(prepared.hram, sig.last<32>(), this->mode_);
+        }
+        return;
+    }
+
+    // At least one signature is invalid, find out which.
+    for (const auto& prepared : batch)
+    {
+        const auto& item = this->items_[prepared.index];
+        results[prepared.index] = item.key.tryVerifySignature(
+                                      item.msg, item.sig, this->mode_
+                                  ) == VerifyResult::Valid;
+    }
+}  // BatchVerifier::verifyChunk
@@ -19,6 +19,7 @@
 // THE SOFTWARE.
 
 // Standard Library Headers
+#include <algorithm>
 #include <bit>
 #include <memory>
 #include <stdexcept>
@@ -34,6 +35,7 @@ typedef __uint128_t uint128_t;
 #include <viper25519/curve25519.hpp>
 
 // Private Viper Ed25519 Headers
+#include "instrumentation.hpp"
 #include "utils.hpp"
 
 using namespace curve25519;
@@ -120,6 +122,16 @@ constexpr auto swap_conditional(bignum25519 &a, bignum25519 &b, uint64_t iswap)
     }
 }
 
+// out = (flag) ? in : out
+constexpr auto move_conditional(
+    bignum25519 &out, bignum25519 const &in, uint64_t flag
+) -> void
+{
+    const uint64_t nb = flag - 1, b = ~nb;
+    for (size_t i = 0; i < out.size(); ++i)
+        out[i] = (out[i] & nb) | (in[i] & b);
+}
+
 constexpr auto contract256_window4_modm(bignum25519 const &in)
     -> std::array<int8_t, 64>
 {
@@ -2669,10 +2681,23 @@ const auto ge25519_niels_sliding_multiples = std::array<PrecomputedPoint, 32>{
              0x000641f248e0a792, 0x0001ed1fc53a6622}}
     )};
 
+/// Pack a point given the inverse of its Z coordinate.
+auto pack_with_zinv(ExtendedPoint const &p, bignum25519 const &zi)
+    -> std::array<uint8_t, 32>
+{
+    auto tx = p.x() * zi;
+    auto ty = p.y() * zi;
+    auto r = bignum25519::contract(ty);
+    auto parity = bignum25519::contract(tx);
+    r[31] ^= static_cast<uint8_t>((parity[0] & 1) << 7);
+    return r;
+}  // pack_with_zinv
+
 }  // unnamed namespace
 
 auto bignum25519::expand(std::span<const uint8_t> in) -> bignum25519
 {
+    VIPER25519_COUNT(field_expand);
     uint64_t x0, x1, x2, x3;
     if (std::endian::native == std::endian::little)
     {
@@ -2716,6 +2741,7 @@ auto bignum25519::expand(std::span<const uint8_t> in) -> bignum25519
 
 auto bignum25519::contract(const bignum25519 &input) -> std::array<uint8_t, 32>
 {
+    VIPER25519_COUNT(field_contract);
     auto t = input;  // make a copy
 
 #define curve25519_contract_carry() \
@@ -2831,6 +2857,7 @@ auto bignum25519::neg() const -> bignum25519
 
 auto bignum25519::mul(bignum25519 const &rhs) const -> bignum25519
 {
+    VIPER25519_COUNT(field_mul);
     auto r0 = (uint128_t)rhs[0];
     auto r1 = (uint128_t)rhs[1];
     auto r2 = (uint128_t)rhs[2];
@@ -2883,6 +2910,7 @@ auto bignum25519::operator*(bignum25519 const &rhs) const -> bignum25519
 
 auto bignum25519::square() const -> bignum25519
 {
+    VIPER25519_COUNT(field_square);
     auto r0 = (uint128_t)(*this)[0];
     auto r1 = (uint128_t)(*this)[1];
     auto r2 = (uint128_t)(*this)[2];
@@ -2994,6 +3022,7 @@ auto bignum25519::pow_two5mtwo0_two250mtwo0() const -> bignum25519
 
 auto bignum25519::recip() const -> bignum25519
 {
+    VIPER25519_COUNT(field_invert);
     auto a alignas(16) = (*this).squareTimes(1);
     auto t0 alignas(16) = a.squareTimes(2);
     auto b alignas(16) = t0 * (*this);
@@ -3155,6 +3184,8 @@ auto bignum25519::barrett_reduce256_modm(
 
     r2[4] = lo128(c) & 0x0000ffffffffff;
 
+    // r = r1 - r2, adding 2^264 if negative. The top limb only holds bits
+    // 224 to 263, so its borrow is worth 2^40 rather than 2^56.
     auto b = (uint64_t)0;
     auto pb = (uint64_t)0;
     auto out = bignum25519{};
@@ -3162,7 +3193,7 @@ auto bignum25519::barrett_reduce256_modm(
     {
         pb += r2[i];
         b = lt_modm(r1[i], pb);
-        out[i] = r1[i] - pb + (b << 56);
+        out[i] = r1[i] - pb + (b << (i + 1 < out.size() ? 56 : 40));
         pb = b;
     }
 
@@ -3332,6 +3363,7 @@ auto PartialPoint::operator[](size_t index) const -> bignum25519
 
 auto PartialPoint::doubleCompleted() const -> CompletedPoint
 {
+    VIPER25519_COUNT(point_double);
     auto a = this->x().square();
     auto b = this->y().square();
     auto c = this->z().square();
@@ -3375,6 +3407,7 @@ auto CompletedPoint::operator[](size_t index) const -> bignum25519
 
 auto CompletedPoint::toPartial() const -> PartialPoint
 {
+    VIPER25519_COUNT(point_convert);
     auto rx = this->x() * this->t();
     auto ry = this->y() * this->z();
     auto rz = this->z() * this->t();
@@ -3383,6 +3416,7 @@ auto CompletedPoint::toPartial() const -> PartialPoint
 
 auto CompletedPoint::toExtended() const -> ExtendedPoint
 {
+    VIPER25519_COUNT(point_convert);
     auto rx = this->x() * this->t();
     auto ry = this->y() * this->z();
     auto rz = this->z() * this->t();
@@ -3398,6 +3432,7 @@ auto ExtendedPoint::operator[](size_t index) const -> bignum25519
 
 auto ExtendedPoint::add(ExtendedPoint const &q) const -> CompletedPoint
 {
+    VIPER25519_COUNT(point_add);
     auto a = this->y() - this->x();
     auto b = this->y() + this->x();
     auto t = q.y() - q.x();
@@ -3417,6 +3452,7 @@ auto ExtendedPoint::add(ExtendedPoint const &q) const -> CompletedPoint
 
 auto ExtendedPoint::add(PrecomputedPoint const &q) const -> ExtendedPoint
 {
+    VIPER25519_COUNT(point_add);
     auto a = (this->y() - this->x()) * q.ysubx();
     auto e = (this->y() + this->x()) * q.xaddy();
     auto h = e + a;
@@ -3431,6 +3467,7 @@ auto ExtendedPoint::add(PrecomputedPoint const &q) const -> ExtendedPoint
 auto ExtendedPoint::add(ExtendedPrecomputedPoint const &q) const
     -> ExtendedPrecomputedPoint
 {
+    VIPER25519_COUNT(point_add);
     auto a = (this->y() - this->x()) * q.ysubx();
     auto x = (this->y() + this->x()) * q.xaddy();
     auto y = x + a;
@@ -3451,6 +3488,7 @@ auto ExtendedPoint::add(
     ExtendedPrecomputedPoint const &q, uint8_t const signbit
 ) const -> CompletedPoint
 {
+    VIPER25519_COUNT(point_add);
     // Derived from: ge25519_pnielsadd_p1p1
     const auto idx1 = static_cast<size_t>(signbit & 0b0001);
     const auto idx2 = static_cast<size_t>((signbit & 0b0001) ^ 1);
@@ -3478,6 +3516,7 @@ auto ExtendedPoint::add(
 auto ExtendedPoint::add(PrecomputedPoint const &q, uint8_t const signbit) const
     -> CompletedPoint
 {
+    VIPER25519_COUNT(point_add);
     // Derived from: ge25519_nielsadd2_p1p1
     const auto idx1 = static_cast<size_t>(signbit & 0b0001);
     const auto idx2 = static_cast<size_t>((signbit & 0b0001) ^ 1);
@@ -3515,6 +3554,7 @@ auto ExtendedPoint::operator+(PrecomputedPoint const &rhs) const
 
 auto ExtendedPoint::add2(PrecomputedPoint const &q) -> ExtendedPoint &
 {
+    VIPER25519_COUNT(point_add);
     auto a = (this->y() - this->x()) * q.ysubx();
     auto e = (this->y() + this->x()) * q.xaddy();
     auto h = e + a;
@@ -3536,6 +3576,7 @@ auto ExtendedPoint::operator+=(PrecomputedPoint const &rhs) -> ExtendedPoint &
 auto ExtendedPoint::toPrecomputedExtendedPoint() const
     -> ExtendedPrecomputedPoint
 {
+    VIPER25519_COUNT(point_convert);
     auto ysubx = this->y() - this->x();
     auto xaddy = this->x() + this->y();
     auto z = this->z();
@@ -3549,6 +3590,7 @@ auto ExtendedPoint::toPrecomputedExtendedPoint() const
 
 auto ExtendedPoint::doubleCompleted() const -> CompletedPoint
 {
+    VIPER25519_COUNT(point_double);
     auto a = this->x().square();
     auto b = this->y().square();
     auto c = this->z().square();
@@ -3574,10 +3616,25 @@ auto ExtendedPoint::doubleExtended() const -> ExtendedPoint
     return t.toExtended();
 }  // ExtendedPoint::doubleExtended
 
+auto ExtendedPoint::mulByCofactor() const -> ExtendedPoint
+{
+    return this->doublePartial().doublePartial().doubleExtended();
+}  // ExtendedPoint::mulByCofactor
+
+auto ExtendedPoint::isIdentity() const -> bool
+{
+    static constexpr auto zero = std::array<uint8_t, 32>{};
+    const auto x = bignum25519::contract(this->x());
+    const auto yz = bignum25519::contract(this->y().subReduce(this->z()));
+    return ed25519::mem_verify<32>(x, zero) &&
+           ed25519::mem_verify<32>(yz, zero);
+}  // ExtendedPoint::isIdentity
+
 auto ExtendedPoint::doubleScalarMultiple(
     bignum25519 const &s1, bignum25519 const &s2
 ) const -> ExtendedPoint
 {
+    VIPER25519_INSTRUMENT(DoubleScalarMul);
     static constexpr auto S1_SWINDOWSIZE = 5;
     static constexpr auto S1_TABLE_SIZE = 1 << (S1_SWINDOWSIZE - 2);
     static constexpr auto S2_SWINDOWSIZE = 7;
@@ -3642,9 +3699,129 @@ auto ExtendedPoint::doubleScalarMultiple(
     return r;
 }  // ExtendedPoint::doubleScalarMultiple
 
+auto ExtendedPoint::scalarMultiple(bignum25519 const &s) const -> ExtendedPoint
+{
+    // Signed radix 16 digits in [-8, 8]
+    const auto b = contract256_window4_modm(s);
+
+    // Multiples [1]p, [2]p, ..., [8]p
+    auto table = std::array<ExtendedPrecomputedPoint, 8>{};
+    table[0] = this->toPrecomputedExtendedPoint();
+    for (size_t i = 0; i < table.size() - 1; i++)
+        table[i + 1] = this->add(table[i]);
+
+    // Select [digit]p without branching or indexing on the digit.
+    auto choose = [&table](int8_t digit)
+    {
+        const auto sign = static_cast<uint64_t>(digit < 0);
+        const auto mask = static_cast<uint64_t>(0) - sign;
+        const auto u = (static_cast<uint64_t>(digit) ^ mask) + sign;
+
+        auto xaddy = bignum25519{1, 0, 0, 0, 0};
+        auto ysubx = bignum25519{1, 0, 0, 0, 0};
+        auto z = bignum25519{1, 0, 0, 0, 0};
+        auto t2d = bignum25519{};
+        for (uint64_t i = 0; i < table.size(); i++)
+        {
+            const auto flag = ((u ^ (i + 1)) - 1) >> 63;
+            move_conditional(xaddy, table[i].xaddy(), flag);
+            move_conditional(ysubx, table[i].ysubx(), flag);
+            move_conditional(z, table[i].z(), flag);
+            move_conditional(t2d, table[i].t2d(), flag);
+        }
+
+        // -(x, y) = (-x, y): swap y + x with y - x and negate t
+        swap_conditional(xaddy, ysubx, sign);
+        auto neg = t2d.neg();
+        move_conditional(t2d, neg, sign);
+        return ExtendedPrecomputedPoint({xaddy, ysubx, z, t2d});
+    };
+
+    auto r = ExtendedPoint{};  // all zeros
+    r.set_y(bignum25519{1, 0, 0, 0, 0});
+    r.set_z(bignum25519{1, 0, 0, 0, 0});
+    r = r.add(choose(b[63]), 0).toExtended();
+    for (size_t i = 63; i-- > 0;)
+    {
+        auto rp = r.doublePartial();
+        rp = rp.doublePartial();
+        rp = rp.doublePartial();
+        r = rp.doubleExtended();
+        r = r.add(choose(b[i]), 0).toExtended();
+    }
+
+    return r;
+}  // ExtendedPoint::scalarMultiple
+
+auto ExtendedPoint::negate() const -> ExtendedPoint
+{
+    return ExtendedPoint(
+        {this->x().neg(), this->y(), this->z(), this->t().neg()}
+    );
+}  // ExtendedPoint::negate
+
+auto ExtendedPoint::multiScalarMultiple(
+    std::span<const bignum25519> scalars, std::span<const ExtendedPoint> points
+) -> ExtendedPoint
+{
+    static constexpr auto SWINDOWSIZE = 5;
+    static constexpr auto TABLE_SIZE = 1 << (SWINDOWSIZE - 2);
+
+    if (scalars.size() != points.size())
+        throw std::invalid_argument("Scalar and point counts must match.");
+    const auto n = points.size();
+
+    // Sliding window digits and odd multiples P, 3P, ..., 15P of each point
+    auto slides = std::vector<std::array<int8_t, 256>>(n);
+    auto pre = std::vector<ExtendedPrecomputedPoint>(n * TABLE_SIZE);
+    for (size_t k = 0; k < n; k++)
+    {
+        slides[k] = contract256_slidingwindow_modm(scalars[k], SWINDOWSIZE);
+        auto d = points[k].doubleExtended();
+        pre[k * TABLE_SIZE] = points[k].toPrecomputedExtendedPoint();
+        for (auto i = 0UL; i < TABLE_SIZE - 1; i++)
+            pre[k * TABLE_SIZE + i + 1] = d.add(pre[k * TABLE_SIZE + i]);
+    }
+
+    // set neutral
+    auto r = ExtendedPoint{};  // all zeros
+    r.set_y(bignum25519{1, 0, 0, 0, 0});
+    r.set_z(bignum25519{1, 0, 0, 0, 0});
+
+    // Share the doublings between all of the points (Straus' method)
+    auto i = 255;  // must be signed
+    auto nonzero = [&](size_t idx)
+    {
+        return std::any_of(
+            slides.begin(), slides.end(),
+            [idx](const auto &slide) { return slide[idx] != 0; }
+        );
+    };
+    while ((i >= 0) && !nonzero(static_cast<size_t>(i))) i--;
+
+    for (; i >= 0; i--)
+    {
+        auto t = r.doubleCompleted();
+        for (size_t k = 0; k < n; k++)
+        {
+            const auto digit = slides[k][static_cast<size_t>(i)];
+            if (!digit) continue;
+            r = t.toExtended();
+            t = r.add(
+                pre[k * TABLE_SIZE + static_cast<size_t>(abs(digit) / 2)],
+                static_cast<uint8_t>(static_cast<unsigned char>(digit) >> 7)
+            );
+        }
+        r = t.toExtended();
+    }
+
+    return r;
+}  // ExtendedPoint::multiScalarMultiple
+
 auto ExtendedPoint::multiplyBasepointByScalar(bignum25519 const &s)
     -> ExtendedPoint
 {
+    VIPER25519_INSTRUMENT(BasepointMul);
     auto b = contract256_window4_modm(s);
     auto t = scalarmult_base_choose_niels(0, b[1]);
 
@@ -3680,17 +3857,47 @@ auto ExtendedPoint::multiplyBasepointByScalar(bignum25519 const &s)
 
 auto ExtendedPoint::pack() const -> std::array<uint8_t, 32>
 {
-    auto zi = this->z().recip();
-    auto tx = this->x() * zi;
-    auto ty = this->y() * zi;
-    auto r = bignum25519::contract(ty);
-    auto parity = bignum25519::contract(tx);
-    r[31] ^= static_cast<uint8_t>((parity[0] & 1) << 7);
-    return r;
+    return pack_with_zinv(*this, this->z().recip());
 }  // ExtendedPoint::pack
 
+auto ExtendedPoint::packBatch(std::span<const ExtendedPoint> points)
+    -> std::vector<std::array<uint8_t, 32>>
+{
+    auto out = std::vector<std::array<uint8_t, 32>>(points.size());
+    if (points.empty()) return out;
+
+    // Montgomery's trick: invert the product of all the Z coordinates once and
+    // recover each individual inverse from the running products.
+    auto products = std::vector<bignum25519>(points.size());
+    products[0] = points[0].z();
+    for (size_t i = 1; i < points.size(); ++i)
+        products[i] = products[i - 1] * points[i].z();
+
+    auto inv = products.back().recip();
+    for (size_t i = points.size() - 1; i > 0; --i)
+    {
+        out[i] = pack_with_zinv(points[i], inv * products[i - 1]);
+        inv = inv * points[i].z();
+    }
+    out[0] = pack_with_zinv(points[0], inv);
+
+    return out;
+}  // ExtendedPoint::packBatch
+
 auto ExtendedPoint::unpack(std::span<const uint8_t> p) -> ExtendedPoint
 {
+    if (p.size() != 32) throw std::invalid_argument("Unexpected point size.");
+    auto r = ExtendedPoint::tryUnpack(p);
+    if (!r) throw std::runtime_error("Invalid root");
+    return *r;
+}  // ExtendedPoint::unpack
+
+auto ExtendedPoint::tryUnpack(std::span<const uint8_t> p) noexcept
+    -> std::optional<ExtendedPoint>
+{
+    VIPER25519_INSTRUMENT(Unpack);
+    if (p.size() != 32) return std::nullopt;
+
     auto parity = static_cast<uint8_t>(p[31] >> 7);
     auto zero = std::array<uint8_t, 32>{};
 
@@ -3715,12 +3922,11 @@ auto ExtendedPoint::unpack(std::span<const uint8_t> p) -> ExtendedPoint
     t = rx.square() * den;
     auto root = t.subReduce(num);
     auto check = bignum25519::contract(root);
-    if (!ed25519::mem_verify(check, zero))
+    if (!ed25519::mem_verify<32>(check, zero))
     {
         t = t.addReduce(num);
         check = bignum25519::contract(t);
-        if (!ed25519::mem_verify(check, zero))
-            throw std::runtime_error("Invalid root");
+        if (!ed25519::mem_verify<32>(check, zero)) return std::nullopt;
         rx = rx * bignum25519::sqrtneg1();
     }
 
@@ -3733,7 +3939,7 @@ auto ExtendedPoint::unpack(std::span<const uint8_t> p) -> ExtendedPoint
     auto rt = rx * ry;
 
     return ExtendedPoint{{rx, ry, rz, rt}};
-}  // ExtendedPoint::pack
+}  // ExtendedPoint::tryUnpack
 
 // This function is largely just used for testing.
 auto curve25519::scalarmult_basepoint(std::array<uint8_t, 32> e)
@@ -19,24 +19,195 @@
 // THE SOFTWARE.
 
 // Standard Library Headers
+#include <limits>
 #include <memory>
 #include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <vector>
 
 // Third-Party Library Headers
-#include <botan/auto_rng.h>
 #include <botan/hash.h>
-#include <botan/rng.h>
-#include <botan/system_rng.h>
 
 // Public Viper25519 Headers
 #include <viper25519/curve25519.hpp>
 #include <viper25519/ed25519.hpp>
+#include <viper25519/point_cache.hpp>
+#include <viper25519/signature_cache.hpp>
 
 // Private Viper25519 code
+#include "instrumentation.hpp"
+#include "random.hpp"
 #include "utils.hpp"
 
 using namespace ed25519;
 
+namespace  // unnamed namespace
+{
+
+/// Keys whose entropy generateBatch draws in one read.
+constexpr size_t BATCH_KEYGEN_CHUNK = 64;
+
+/// Check the raw encodings of a signature and public key under the given
+/// rules before any field or group arithmetic is done. Returns the failure,
+/// or std::nullopt if the encodings are acceptable.
+auto check_encodings(
+    std::span<const uint8_t, ED25519_KEY_SIZE> pub,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    VerifyMode mode
+) noexcept -> std::optional<VerifyResult>
+{
+    const auto sig_r = sig.first<32>();
+    const auto sig_s = sig.last<32>();
+    switch (mode)
+    {
+        case VerifyMode::Legacy:
+            if (sig[63] & 224) return VerifyResult::MalformedSignature;
+            break;
+        case VerifyMode::Rfc8032:
+            if (!is_canonical_scalar(sig_s) || !is_canonical_point(sig_r) ||
+                has_small_order(sig_r))
+                return VerifyResult::MalformedSignature;
+            if (!is_canonical_point(pub) || has_small_order(pub))
+                return VerifyResult::MalformedPublicKey;
+            break;
+        case VerifyMode::Zip215:
+            if (!is_canonical_scalar(sig_s))
+                return VerifyResult::MalformedSignature;
+            break;
+    }
+    return std::nullopt;
+}  // check_encodings
+
+/// Check the verification equation given the hash H(R,A,M).
+auto check_equation(
+    std::span<const uint8_t, ED25519_KEY_SIZE> pub,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    std::span<const uint8_t, 64> hash,
+    VerifyMode mode
+) noexcept -> VerifyResult
+{
+    const auto sig_r = sig.first<32>();
+    const auto sig_s = sig.last<32>();
+
+    // A signature already verified under the same rules needs no curve work.
+    if (SignatureCache::contains(hash, sig_s, mode)) return VerifyResult::Valid;
+
+    const auto a = PointCache::unpack(pub);
+    if (!a) return VerifyResult::MalformedPublicKey;
+
+    auto hram = curve25519::bignum25519::expand256_modm(hash);
+
+    // S
+    auto s = curve25519::bignum25519::expand256_modm(sig_s);
+
+    // SB - H(R,A,m)A
+    auto r = a->doubleScalarMultiple(hram, s);
+
+    auto valid = false;
+    if (mode == VerifyMode::Zip215)
+    {
+        // check that [8](SB - H(R,A,m)A) - [8]R is the identity, unpack
+        // already returns -R and the doublings restore the T coordinate that
+        // doubleScalarMultiple leaves unset
+        const auto neg_r = curve25519::ExtendedPoint::tryUnpack(sig_r);
+        if (!neg_r) return VerifyResult::MalformedSignature;
+        valid = (r.mulByCofactor() + neg_r->mulByCofactor()).isIdentity();
+    }
+    else
+    {
+        auto check_r = r.pack();  // 32 bytes
+
+        // check that R = SB - H(R,A,m)A
+        valid = mem_verify<32>(sig_r, check_r);
+    }
+
+    if (!valid) return VerifyResult::Invalid;
+    SignatureCache::insert(hash, sig_s, mode);
+    return VerifyResult::Valid;
+}  // check_equation
+
+/// Build the RFC 8032 dom2(F, C) prefix used by Ed25519ph and Ed25519ctx.
+auto dom2(uint8_t flag, std::span<const uint8_t> context)
+    -> std::vector<uint8_t>
+{
+    static constexpr auto prefix =
+        std::string_view{"SigEd25519 no Ed25519 collisions"};
+    if (context.size() > ED25519_MAX_CONTEXT_SIZE)
+        throw std::invalid_argument("Context too long.");
+
+    auto dom = std::vector<uint8_t>(prefix.begin(), prefix.end());
+    dom.push_back(flag);
+    dom.push_back(static_cast<uint8_t>(context.size()));
+    dom.insert(dom.end(), context.begin(), context.end());
+    return dom;
+}  // dom2
+
+/// Return the SHA-512 hasher of the calling thread. It is created once per
+/// thread, so the verification hot path neither allocates nor can fail after
+/// the first call, which throws if Botan provides no SHA-512. Every user must
+/// finish with final(), which also resets it.
+auto thread_sha512() -> Botan::HashFunction&
+{
+    thread_local const auto sha512 =
+        Botan::HashFunction::create_or_throw("SHA-512");
+    return *sha512;
+}  // thread_sha512
+
+/// Verify a signature whose hash H(dom || R || A || M) carries the given
+/// domain prefix (empty for pure Ed25519).
+auto verify_with_domain(
+    std::span<const uint8_t, ED25519_KEY_SIZE> pub,
+    std::span<const uint8_t> dom,
+    MessageSegments msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    VerifyMode mode
+) noexcept -> VerifyResult
+{
+    VIPER25519_INSTRUMENT(Verify);
+    if (const auto failure = check_encodings(pub, sig, mode)) return *failure;
+
+    // hram = H(dom,R,A,m)
+    auto hash = std::array<uint8_t, 64>{};
+    try
+    {
+        auto& sha512 = thread_sha512();
+        sha512.update(dom.data(), dom.size());
+        sha512.update(sig.data(), 32);
+        sha512.update(pub.data(), pub.size());
+        for (const auto& segment : msg)
+            sha512.update(segment.data(), segment.size());
+        sha512.final(hash.data());
+    }
+    catch (...)
+    {
+        // Without a hash the signature cannot be accepted.
+        return VerifyResult::Invalid;
+    }
+
+    return check_equation(pub, sig, hash, mode);
+}  // verify_with_domain
+
+/// Convert a verification result to the return value or exception of the
+/// throwing verification functions.
+auto result_to_bool(VerifyResult result) -> bool
+{
+    switch (result)
+    {
+        case VerifyResult::Valid:
+            return true;
+        case VerifyResult::MalformedSignature:
+            throw std::invalid_argument("Invalid signature.");
+        case VerifyResult::MalformedPublicKey:
+            throw std::runtime_error("Invalid root");
+        case VerifyResult::Invalid:
+            break;
+    }
+    return false;
+}  // result_to_bool
+
+}  // unnamed namespace
+
 PrivateKey::PrivateKey(std::span<const uint8_t, ED25519_KEY_SIZE> prv)
 {
     std::move(prv.begin(), prv.end(), this->prv_.begin());
@@ -44,13 +215,8 @@ PrivateKey::PrivateKey(std::span<const uint8_t, ED25519_KEY_SIZE> prv)
 
 auto PrivateKey::generate() -> PrivateKey
 {
-    // Use the Botan random number generator for generating the entropy.
-    std::unique_ptr<Botan::RandomNumberGenerator> rng;
-#if defined(BOTAN_HAS_SYSTEM_RNG)
-    rng.reset(new Botan::System_RNG);
-#else
-    rng.reset(new Botan::AutoSeeded_RNG);
-#endif
+    // Use the buffered per-thread generator for generating the entropy.
+    auto& rng = ChaCha20Rng::local();
 
     // The randomly generated key should meet validity requirements within a
     // couple attempts, but we set a maximum number of tries here in order to
@@ -68,7 +234,7 @@ auto PrivateKey::generate() -> PrivateKey
         if (n_retries > max_retries) throw std::runtime_error("RNG error");
 
         // Create a random 32-byte secret key.
-        rng->randomize(skey.data(), ED25519_KEY_SIZE);
+        rng.randomize(skey);
 
         // SHA-512 hash of the secret key
         const auto sha512 = Botan::HashFunction::create("SHA-512");
@@ -82,6 +248,73 @@ auto PrivateKey::generate() -> PrivateKey
     return PrivateKey(std::span(skey).first<ED25519_KEY_SIZE>());
 }  // PrivateKey::generate
 
+auto PrivateKey::generateBatch(size_t n)
+    -> std::vector<std::pair<PrivateKey, PublicKey>>
+{
+    if (n > std::numeric_limits<size_t>::max() / ED25519_KEY_SIZE)
+        throw std::length_error("Too many keys requested.");
+
+    auto& rng = ChaCha20Rng::local();
+    const auto max_retries = 10000UL;
+    const auto sha512 = Botan::HashFunction::create_or_throw("SHA-512");
+    auto keyhash = Botan::SecureVector<uint8_t>(ED25519_EXTENDED_KEY_SIZE);
+
+    // The private keys are constructed in place and the public keys filled
+    // in once they have all been packed, so no secret is copied.
+    auto keys = std::vector<std::pair<PrivateKey, PublicKey>>();
+    auto points = std::vector<curve25519::ExtendedPoint>();
+    keys.reserve(n);
+    points.reserve(n);
+    for (size_t first = 0; first < n; first += BATCH_KEYGEN_CHUNK)
+    {
+        // Draw the entropy for a chunk of keys in one read. The buffer is
+        // wiped when it goes out of scope. Rejected candidates are redrawn
+        // individually, which only happens for roughly half the keys.
+        const auto count = std::min(BATCH_KEYGEN_CHUNK, n - first);
+        auto seeds = Botan::SecureVector<uint8_t>(count * ED25519_KEY_SIZE);
+        rng.randomize(seeds);
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto seed =
+                std::span(seeds).subspan(i * ED25519_KEY_SIZE).first<32>();
+
+            // The hash used for the validity check is the same hash used to
+            // extend the key, so the scalar falls out of the rejection loop.
+            auto n_retries = 0UL;
+            while (true)
+            {
+                sha512->update(seed.data(), seed.size());
+                sha512->final(keyhash.data());
+                if ((keyhash[31] & 0b00100000) == 0) break;
+
+                if (++n_retries > max_retries)
+                    throw std::runtime_error("RNG error");
+                rng.randomize(seed);
+            }
+
+            keyhash[0] &= 0b11111000;
+            keyhash[31] &= 0b00011111;
+            keyhash[31] |= 0b01000000;
+            auto a = curve25519::bignum25519::expand256_modm(
+                {keyhash.data(), 32}
+            );
+            points.push_back(
+                curve25519::ExtendedPoint::multiplyBasepointByScalar(a)
+            );
+            keys.emplace_back(
+                std::piecewise_construct, std::forward_as_tuple(seed),
+                std::forward_as_tuple(PubKeyByteArray{})
+            );
+        }
+    }
+
+    // Pack all of the public keys with a single shared inversion.
+    const auto pkeys = curve25519::ExtendedPoint::packBatch(points);
+    for (size_t i = 0; i < n; ++i) keys[i].second = PublicKey(pkeys[i]);
+    return keys;
+}  // PrivateKey::generateBatch
+
 auto PrivateKey::isValid() const -> bool
 {
     const auto sha512 = Botan::HashFunction::create("SHA-512");
@@ -126,6 +359,37 @@ auto PrivateKey::sign(std::span<const uint8_t> msg) const
     return ext_key.sign(msg);
 }  // PrivateKey::sign
 
+auto PrivateKey::sign(MessageSegments msg) const
+    -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
+{
+    auto ext_key = this->extend();
+    return ext_key.sign(msg);
+}  // PrivateKey::sign
+
+auto PrivateKey::signPrehashed(
+    std::span<const uint8_t, ED25519_PREHASH_SIZE> digest,
+    std::span<const uint8_t> context
+) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
+{
+    auto ext_key = this->extend();
+    return ext_key.signPrehashed(digest, context);
+}  // PrivateKey::signPrehashed
+
+auto PrivateKey::signWithContext(
+    std::span<const uint8_t> msg, std::span<const uint8_t> context
+) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
+{
+    auto ext_key = this->extend();
+    return ext_key.signWithContext(msg, context);
+}  // PrivateKey::signWithContext
+
+auto PrivateKey::signBatch(std::span<const std::span<const uint8_t>> msgs) const
+    -> std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>
+{
+    auto ext_key = this->extend();
+    return ext_key.signBatch(msgs);
+}  // PrivateKey::signBatch
+
 PublicKey::PublicKey(std::span<const uint8_t, ED25519_KEY_SIZE> pub)
 {
     std::copy_n(pub.begin(), ED25519_KEY_SIZE, this->pub_.begin());
@@ -133,47 +397,187 @@ PublicKey::PublicKey(std::span<const uint8_t, ED25519_KEY_SIZE> pub)
 
 auto PublicKey::verifySignature(
     std::span<const uint8_t> msg,
-    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    VerifyMode mode
 ) const -> bool
 {
-    if (sig[63] & 224) throw std::invalid_argument("Invalid signature.");
-
-    // This may also throw an exception
-    const auto a = curve25519::ExtendedPoint::unpack(this->pub_);
-
-    // hram = H(R,A,m)
-    const auto sha512 = Botan::HashFunction::create("SHA-512");
-    sha512->update(sig.data(), 32);
-    sha512->update(this->pub_.data(), this->pub_.size());
-    sha512->update(msg.data(), msg.size());
-    auto hash = sha512->final();
-    auto hram = curve25519::bignum25519::expand256_modm(hash);
-
-    // S
-    auto s = curve25519::bignum25519::expand256_modm({sig.data() + 32, 32});
+    return this->verifySignature(MessageSegments(&msg, 1), sig, mode);
+}  // PublicKey::verifySignature
 
-    // SB - H(R,A,m)A
-    auto r = a.doubleScalarMultiple(hram, s);
-    auto check_r = r.pack();  // 32 bytes
+auto PublicKey::verifySignature(
+    MessageSegments msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    VerifyMode mode
+) const -> bool
+{
+    return result_to_bool(this->tryVerifySignature(msg, sig, mode));
+}  // PublicKey::verifySignature
 
-    // check that R = SB - H(R,A,m)A
-    return mem_verify({sig.data(), 32}, check_r);
-}  // PublicKey::verify
+auto PublicKey::tryVerifySignature(
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    VerifyMode mode
+) const noexcept -> VerifyResult
+{
+    return this->tryVerifySignature(MessageSegments(&msg, 1), sig, mode);
+}  // PublicKey::tryVerifySignature
+
+auto PublicKey::tryVerifySignature(
+    MessageSegments msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    VerifyMode mode
+) const noexcept -> VerifyResult
+{
+    return verify_with_domain(this->pub_, {}, msg, sig, mode);
+}  // PublicKey::tryVerifySignature
+
+auto PublicKey::verifyPrehashed(
+    std::span<const uint8_t, ED25519_PREHASH_SIZE> digest,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    std::span<const uint8_t> context,
+    VerifyMode mode
+) const -> bool
+{
+    const auto dom = dom2(1, context);
+    const auto msg = std::span<const uint8_t>(digest);
+    return result_to_bool(verify_with_domain(
+        this->pub_, dom, MessageSegments(&msg, 1), sig, mode
+    ));
+}  // PublicKey::verifyPrehashed
+
+auto PublicKey::verifyWithContext(
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    std::span<const uint8_t> context,
+    VerifyMode mode
+) const -> bool
+{
+    if (context.empty()) throw std::invalid_argument("Context is empty.");
+    const auto dom = dom2(0, context);
+    return result_to_bool(verify_with_domain(
+        this->pub_, dom, MessageSegments(&msg, 1), sig, mode
+    ));
+}  // PublicKey::verifyWithContext
 
 auto PublicKey::pointAdd(const PublicKey& rhs) const -> PublicKey
 {
-    const auto rhs_bytes = rhs.bytes();
+    auto res = this->tryPointAdd(rhs);
+    if (!res) throw std::runtime_error("Invalid root");
+    return *res;
+}  // PublicKey::pointAdd
 
-    // This may throw an exception
-    const auto p = curve25519::ExtendedPoint::unpack(this->pub_);
-    const auto q = curve25519::ExtendedPoint::unpack(rhs_bytes);
+auto PublicKey::tryPointAdd(const PublicKey& rhs) const noexcept
+    -> std::optional<PublicKey>
+{
+    const auto p = curve25519::ExtendedPoint::tryUnpack(this->pub_);
+    const auto q = curve25519::ExtendedPoint::tryUnpack(rhs.bytes());
+    if (!p || !q) return std::nullopt;
 
-    const auto r = p + q;
+    const auto r = *p + *q;
     auto res = r.pack();
 
     res[31] ^= 0x80;
     return PublicKey(res);
-}  // PublicKey::pointAdd
+}  // PublicKey::tryPointAdd
+
+struct Verifier::Impl
+{
+    std::unique_ptr<Botan::HashFunction> sha512 =
+        Botan::HashFunction::create_or_throw("SHA-512");
+    PubKeyByteArray pub{};
+    std::array<uint8_t, ED25519_SIGNATURE_SIZE> sig{};
+    VerifyMode mode = VerifyMode::Legacy;
+    std::optional<VerifyResult> failure;
+    bool active = false;
+};
+
+Verifier::Verifier() : impl_{std::make_unique<Impl>()} {}
+
+Verifier::~Verifier() = default;
+
+Verifier::Verifier(Verifier&&) noexcept = default;
+
+auto Verifier::operator=(Verifier&&) noexcept -> Verifier& = default;
+
+auto Verifier::init(
+    const PublicKey& key,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    VerifyMode mode
+) -> void
+{
+    // A moved-from verifier has no state until it is initialised again.
+    if (!this->impl_) this->impl_ = std::make_unique<Impl>();
+    auto& impl = *this->impl_;
+    std::copy(key.bytes().begin(), key.bytes().end(), impl.pub.begin());
+    std::copy(sig.begin(), sig.end(), impl.sig.begin());
+    impl.mode = mode;
+    impl.failure = check_encodings(impl.pub, impl.sig, mode);
+    impl.active = true;
+
+    // hram = H(R,A,m), the message follows through update
+    impl.sha512->clear();
+    impl.sha512->update(impl.sig.data(), 32);
+    impl.sha512->update(impl.pub.data(), impl.pub.size());
+}  // Verifier::init
+
+auto Verifier::update(std::span<const uint8_t> chunk) -> void
+{
+    if (!this->impl_ || !this->impl_->active)
+        throw std::logic_error("Verifier is not initialized.");
+    auto& impl = *this->impl_;
+
+    // Input for a signature that is already known to fail is not hashed.
+    if (!impl.failure) impl.sha512->update(chunk.data(), chunk.size());
+}  // Verifier::update
+
+auto Verifier::final() -> bool
+{
+    if (!this->impl_ || !this->impl_->active)
+        throw std::logic_error("Verifier is not initialized.");
+    return result_to_bool(this->tryFinal());
+}  // Verifier::final
+
+auto Verifier::tryFinal() noexcept -> VerifyResult
+{
+    VIPER25519_INSTRUMENT(Verify);
+    if (!this->impl_ || !this->impl_->active) return VerifyResult::Invalid;
+    auto& impl = *this->impl_;
+    impl.active = false;
+
+    auto hash = std::array<uint8_t, 64>{};
+    impl.sha512->final(hash.data());
+    if (impl.failure) return *impl.failure;
+    return check_equation(impl.pub, impl.sig, hash, impl.mode);
+}  // Verifier::tryFinal
+
+struct Prehash::Impl
+{
+    std::unique_ptr<Botan::HashFunction> sha512 =
+        Botan::HashFunction::create_or_throw("SHA-512");
+};
+
+Prehash::Prehash() : impl_{std::make_unique<Impl>()} {}
+
+Prehash::~Prehash() = default;
+
+Prehash::Prehash(Prehash&&) noexcept = default;
+
+auto Prehash::operator=(Prehash&&) noexcept -> Prehash& = default;
+
+auto Prehash::update(std::span<const uint8_t> chunk) -> void
+{
+    // A moved-from object starts a new message.
+    if (!this->impl_) this->impl_ = std::make_unique<Impl>();
+    this->impl_->sha512->update(chunk.data(), chunk.size());
+}  // Prehash::update
+
+auto Prehash::final() -> std::array<uint8_t, ED25519_PREHASH_SIZE>
+{
+    if (!this->impl_) this->impl_ = std::make_unique<Impl>();
+    auto digest = std::array<uint8_t, ED25519_PREHASH_SIZE>{};
+    this->impl_->sha512->final(digest.data());
+    return digest;
+}  // Prehash::final
 
 ExtendedPrivateKey::ExtendedPrivateKey(
     std::span<const uint8_t, ED25519_EXTENDED_KEY_SIZE> prv
@@ -206,6 +610,7 @@ auto ExtendedPrivateKey::isValid() const -> bool
 
 auto ExtendedPrivateKey::publicKey() const -> PublicKey
 {
+    VIPER25519_INSTRUMENT(KeyDerive);
     // Expand the lower 32 bytes of the private key to large scalar
     auto kl = std::span<const uint8_t>{this->prv_.data(), 32};
     auto a = curve25519::bignum25519::expand256_modm(kl);
@@ -221,13 +626,48 @@ auto ExtendedPrivateKey::publicKey() const -> PublicKey
 auto ExtendedPrivateKey::sign(std::span<const uint8_t> msg) const
     -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
 {
+    return this->sign(MessageSegments(&msg, 1));
+}  // ExtendedPrivateKey::sign
+
+auto ExtendedPrivateKey::sign(MessageSegments msg) const
+    -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
+{
+    return this->signWithDomain({}, msg);
+}  // ExtendedPrivateKey::sign
+
+auto ExtendedPrivateKey::signPrehashed(
+    std::span<const uint8_t, ED25519_PREHASH_SIZE> digest,
+    std::span<const uint8_t> context
+) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
+{
+    const auto dom = dom2(1, context);
+    const auto msg = std::span<const uint8_t>(digest);
+    return this->signWithDomain(dom, MessageSegments(&msg, 1));
+}  // ExtendedPrivateKey::signPrehashed
+
+auto ExtendedPrivateKey::signWithContext(
+    std::span<const uint8_t> msg, std::span<const uint8_t> context
+) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
+{
+    if (context.empty()) throw std::invalid_argument("Context is empty.");
+    const auto dom = dom2(0, context);
+    return this->signWithDomain(dom, MessageSegments(&msg, 1));
+}  // ExtendedPrivateKey::signWithContext
+
+auto ExtendedPrivateKey::signWithDomain(
+    std::span<const uint8_t> dom, MessageSegments msg
+) const -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
+{
+    VIPER25519_INSTRUMENT(Sign);
     // Derive the public key
     auto pk = this->publicKey().bytes();
 
-    // r = H(aExt[32..64], m)
+    // r = H(dom, aExt[32..64], m)
     const auto sha512 = Botan::HashFunction::create("SHA-512");
+    sha512->update(dom.data(), dom.size());
     sha512->update(this->prv_.data() + 32, 32);
-    sha512->update(msg.data(), msg.size());
+    for (const auto& segment : msg)
+        sha512->update(segment.data(), segment.size());
     auto hashr = sha512->final();
     auto r = curve25519::bignum25519::expand256_modm(hashr);
 
@@ -235,10 +675,12 @@ auto ExtendedPrivateKey::sign(std::span<const uint8_t> msg) const
     auto rb = curve25519::ExtendedPoint::multiplyBasepointByScalar(r);
     auto rs = rb.pack();
 
-    // S = H(R,A,m)..
+    // S = H(dom,R,A,m)..
+    sha512->update(dom.data(), dom.size());
     sha512->update(rs.data(), rs.size());
     sha512->update(pk.data(), pk.size());
-    sha512->update(msg.data(), msg.size());
+    for (const auto& segment : msg)
+        sha512->update(segment.data(), segment.size());
     auto hram = sha512->final();
     auto s = curve25519::bignum25519::expand256_modm(hram);
 
@@ -258,7 +700,58 @@ auto ExtendedPrivateKey::sign(std::span<const uint8_t> msg) const
     std::copy_n(rs.begin(), 32, sig.begin());
     std::copy_n(sbytes.begin(), 32, sig.begin() + 32);
     return sig;
-}  // ExtendedPrivateKey::sign
+}  // ExtendedPrivateKey::signWithDomain
+
+auto ExtendedPrivateKey::signBatch(
+    std::span<const std::span<const uint8_t>> msgs
+) const -> std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>
+{
+    // Derive the public key and secret scalar once for all messages
+    auto pk = this->publicKey().bytes();
+    auto kl = std::span<const uint8_t>{this->prv_.data(), 32};
+    auto a = curve25519::bignum25519::expand256_modm(kl);
+
+    // r = H(aExt[32..64], m), R = rB
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    auto rs = std::vector<curve25519::bignum25519>();
+    auto rbs = std::vector<curve25519::ExtendedPoint>();
+    rs.reserve(msgs.size());
+    rbs.reserve(msgs.size());
+    for (const auto& msg : msgs)
+    {
+        sha512->update(this->prv_.data() + 32, 32);
+        sha512->update(msg.data(), msg.size());
+        auto hashr = sha512->final();
+        rs.push_back(curve25519::bignum25519::expand256_modm(hashr));
+        rbs.push_back(
+            curve25519::ExtendedPoint::multiplyBasepointByScalar(rs.back())
+        );
+    }
+
+    // Encode all R points sharing one inversion
+    const auto packed = curve25519::ExtendedPoint::packBatch(rbs);
+
+    auto sigs = std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>(
+        msgs.size()
+    );
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        // S = (r + H(R,A,m)a) mod L
+        sha512->update(packed[i].data(), packed[i].size());
+        sha512->update(pk.data(), pk.size());
+        sha512->update(msgs[i].data(), msgs[i].size());
+        auto hram = sha512->final();
+        auto s = curve25519::bignum25519::expand256_modm(hram);
+        s = curve25519::bignum25519::mul256_modm(s, a);
+        s = curve25519::bignum25519::add256_modm(s, rs[i]);
+        auto sbytes = curve25519::bignum25519::contract256_modm(s);
+
+        std::copy_n(packed[i].begin(), 32, sigs[i].begin());
+        std::copy_n(sbytes.begin(), 32, sigs[i].begin() + 32);
+    }
+
+    return sigs;
+}  // ExtendedPrivateKey::signBatch
 
 auto ExtendedPrivateKey::scalerAddLowerBytes(const ExtendedPrivateKey& rhs
 ) const -> std::array<uint8_t, 32>
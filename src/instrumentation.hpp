@@ -0,0 +1,69 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_INSTRUMENTATION_HPP_
+#define VIPER25519_INSTRUMENTATION_HPP_
+
+// Hooks placed at the start of instrumented operations. They expand to
+// nothing unless enabled at build time.
+//
+// The process-wide state behind the hooks (latency.cpp, perf_counters.cpp)
+// is allocated on first use and never destroyed, so that operations running
+// during program exit, e.g. in static destructors or detached threads, can
+// still record into it.
+
+#ifdef VIPER25519_LATENCY
+#include <viper25519/latency.hpp>
+#define VIPER25519_LATENCY_SCOPE(op)                   \
+    const auto viper25519_latency_scope_ =             \
+        ed25519::LatencyScope(ed25519::Operation::op)
+#else
+#define VIPER25519_LATENCY_SCOPE(op) static_cast<void>(0)
+#endif
+
+#ifdef VIPER25519_PERF_COUNTERS
+#include <viper25519/perf_counters.hpp>
+#define VIPER25519_PERF_SCOPE(op)                      \
+    const auto viper25519_perf_scope_ =                \
+        ed25519::PerfScope(ed25519::Operation::op)
+#else
+#define VIPER25519_PERF_SCOPE(op) static_cast<void>(0)
+#endif
+
+// VIPER25519_COUNT(counter) adds one to a field of the calling thread's
+// OpCounts.
+#ifdef VIPER25519_OPCOUNT
+#include <viper25519/op_counters.hpp>
+namespace ed25519::detail
+{
+extern thread_local OpCounts thread_op_counts;
+}  // namespace ed25519::detail
+#define VIPER25519_COUNT(counter) \
+    static_cast<void>(++ed25519::detail::thread_op_counts.counter)
+#else
+#define VIPER25519_COUNT(counter) static_cast<void>(0)
+#endif
+
+/// @brief Instrument the enclosing scope as the given Operation.
+#define VIPER25519_INSTRUMENT(op) \
+    VIPER25519_PERF_SCOPE(op);    \
+    VIPER25519_LATENCY_SCOPE(op)
+
+#endif  // VIPER25519_INSTRUMENTATION_HPP_
@@ -0,0 +1,333 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define VIPER25519_HAS_TSC 1
+#endif
+
+// Public Viper25519 Headers
+#include <viper25519/latency.hpp>
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+// Values below 2^SUB_BITS have a bucket each. Above that every power of two
+// is split into 2^(SUB_BITS - 1) buckets, bounding the relative error of a
+// bucket by 2^-(SUB_BITS - 1).
+constexpr auto SUB_BITS = 6U;
+constexpr auto SUB_COUNT = uint64_t{1} << SUB_BITS;
+constexpr auto HALF_COUNT = SUB_COUNT / 2;
+
+static_assert(
+    LatencyRecorder::BUCKET_COUNT == SUB_COUNT + (64 - SUB_BITS) * HALF_COUNT
+);
+
+constexpr auto bucket_index(uint64_t v) -> size_t
+{
+    if (v < SUB_COUNT) return static_cast<size_t>(v);
+    const auto shift = static_cast<unsigned>(std::bit_width(v)) - SUB_BITS;
+    const auto mantissa = v >> shift;  // in [HALF_COUNT, SUB_COUNT)
+    return static_cast<size_t>(
+        SUB_COUNT + (shift - 1) * HALF_COUNT + (mantissa - HALF_COUNT)
+    );
+}  // bucket_index
+
+/// Return the smallest value of a bucket and the width of the bucket.
+constexpr auto bucket_range(size_t index) -> std::pair<uint64_t, uint64_t>
+{
+    if (index < SUB_COUNT) return {index, 1};
+    const auto shift = (index - SUB_COUNT) / HALF_COUNT + 1;
+    const auto mantissa = (index - SUB_COUNT) % HALF_COUNT + HALF_COUNT;
+    return {uint64_t{mantissa} << shift, uint64_t{1} << shift};
+}  // bucket_range
+
+static_assert(bucket_index(SUB_COUNT - 1) == SUB_COUNT - 1);
+static_assert(bucket_index(SUB_COUNT) == SUB_COUNT);
+static_assert(
+    bucket_index(std::numeric_limits<uint64_t>::max()) ==
+    LatencyRecorder::BUCKET_COUNT - 1
+);
+static_assert(bucket_range(bucket_index(1000003)).first <= 1000003);
+
+struct Histogram
+{
+    std::array<std::atomic<uint64_t>, LatencyRecorder::BUCKET_COUNT> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> min{std::numeric_limits<uint64_t>::max()};
+    std::atomic<uint64_t> max{0};
+
+    auto clear() noexcept -> void
+    {
+        for (auto& b : this->buckets) b.store(0, std::memory_order_relaxed);
+        this->count.store(0, std::memory_order_relaxed);
+        this->sum.store(0, std::memory_order_relaxed);
+        this->min.store(
+            std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed
+        );
+        this->max.store(0, std::memory_order_relaxed);
+    }
+};
+
+/// Backing state of the recorder, never destroyed (see instrumentation.hpp).
+struct LatencyState
+{
+    std::array<Histogram, OPERATION_COUNT> histograms;
+    std::atomic<bool> enabled{false};
+};
+
+auto state() -> LatencyState&
+{
+    static auto* s = new LatencyState();
+    return *s;
+}  // state
+
+/// Return the number of clock ticks per nanosecond, measured once.
+auto ticks_per_ns() -> double
+{
+#ifdef VIPER25519_HAS_TSC
+    static const auto rate = []
+    {
+        using clock = std::chrono::steady_clock;
+        const auto t0 = clock::now();
+        const auto c0 = __rdtsc();
+        auto t1 = t0;
+        while (t1 - t0 < std::chrono::milliseconds(10)) t1 = clock::now();
+        const auto c1 = __rdtsc();
+        const auto ns =
+            std::chrono::duration<double, std::nano>(t1 - t0).count();
+        return static_cast<double>(c1 - c0) / ns;
+    }();
+    return rate;
+#else
+    return 1.0;
+#endif
+}  // ticks_per_ns
+
+/// Return the tick value at which the given rank is reached.
+auto value_at_rank(const Histogram& h, uint64_t rank) -> uint64_t
+{
+    auto seen = uint64_t{0};
+    for (size_t i = 0; i < h.buckets.size(); ++i)
+    {
+        seen += h.buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            // Report the middle of the bucket, within the observed range.
+            const auto [low, width] = bucket_range(i);
+            const auto mid = low + (width - 1) / 2;
+            return std::clamp(
+                mid,
+                h.min.load(std::memory_order_relaxed),
+                h.max.load(std::memory_order_relaxed)
+            );
+        }
+    }
+    return h.max.load(std::memory_order_relaxed);
+}  // value_at_rank
+
+auto to_ns(uint64_t ticks) -> double
+{
+    return static_cast<double>(ticks) / ticks_per_ns();
+}  // to_ns
+
+auto format(const char* fmt, auto... args) -> std::string
+{
+    const auto len = std::snprintf(nullptr, 0, fmt, args...);
+    auto out = std::string(static_cast<size_t>(len) + 1, '\0');
+    std::snprintf(out.data(), out.size(), fmt, args...);
+    out.pop_back();
+    return out;
+}  // format
+
+}  // unnamed namespace
+
+auto LatencyRecorder::setEnabled(bool enabled) noexcept -> void
+{
+    state().enabled.store(enabled, std::memory_order_relaxed);
+}  // LatencyRecorder::setEnabled
+
+auto LatencyRecorder::enabled() noexcept -> bool
+{
+    return state().enabled.load(std::memory_order_relaxed);
+}  // LatencyRecorder::enabled
+
+auto LatencyRecorder::available() noexcept -> bool
+{
+#ifdef VIPER25519_LATENCY
+    return true;
+#else
+    return false;
+#endif
+}  // LatencyRecorder::available
+
+auto LatencyRecorder::reset() noexcept -> void
+{
+    for (auto& h : state().histograms) h.clear();
+}  // LatencyRecorder::reset
+
+auto LatencyRecorder::record(Operation op, uint64_t ticks) noexcept -> void
+{
+    auto& h = state().histograms[static_cast<size_t>(op)];
+    h.buckets[bucket_index(ticks)].fetch_add(1, std::memory_order_relaxed);
+    h.count.fetch_add(1, std::memory_order_relaxed);
+    h.sum.fetch_add(ticks, std::memory_order_relaxed);
+
+    auto lo = h.min.load(std::memory_order_relaxed);
+    while (ticks < lo &&
+           !h.min.compare_exchange_weak(lo, ticks, std::memory_order_relaxed))
+    {
+    }
+    auto hi = h.max.load(std::memory_order_relaxed);
+    while (ticks > hi &&
+           !h.max.compare_exchange_weak(hi, ticks, std::memory_order_relaxed))
+    {
+    }
+}  // LatencyRecorder::record
+
+auto LatencyRecorder::percentile(Operation op, double q) -> double
+{
+    const auto& h = state().histograms[static_cast<size_t>(op)];
+    const auto count = h.count.load(std::memory_order_relaxed);
+    if (count == 0) return 0.0;
+
+    const auto n = static_cast<double>(count);
+    const auto rank = std::clamp(std::ceil(q * n), 1.0, n);
+    return to_ns(value_at_rank(h, static_cast<uint64_t>(rank)));
+}  // LatencyRecorder::percentile
+
+auto LatencyRecorder::summary(Operation op) -> LatencySummary
+{
+    const auto& h = state().histograms[static_cast<size_t>(op)];
+    auto s = LatencySummary{};
+    s.count = h.count.load(std::memory_order_relaxed);
+    if (s.count == 0) return s;
+
+    s.min_ns = to_ns(h.min.load(std::memory_order_relaxed));
+    s.max_ns = to_ns(h.max.load(std::memory_order_relaxed));
+    s.mean_ns = to_ns(h.sum.load(std::memory_order_relaxed)) /
+                static_cast<double>(s.count);
+    s.p50_ns = percentile(op, 0.5);
+    s.p90_ns = percentile(op, 0.9);
+    s.p99_ns = percentile(op, 0.99);
+    s.p999_ns = percentile(op, 0.999);
+    return s;
+}  // LatencyRecorder::summary
+
+auto LatencyRecorder::dumpText() -> std::string
+{
+    auto out = format(
+        "%-18s %10s %10s %10s %10s %10s %10s %10s %10s\n", "operation (us)",
+        "count", "min", "mean", "p50", "p90", "p99", "p99.9", "max"
+    );
+    for (size_t i = 0; i < OPERATION_COUNT; ++i)
+    {
+        const auto op = static_cast<Operation>(i);
+        const auto s = summary(op);
+        if (s.count == 0) continue;
+        out += format(
+            "%-18s %10llu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n",
+            operationName(op).data(), static_cast<unsigned long long>(s.count),
+            s.min_ns / 1e3, s.mean_ns / 1e3, s.p50_ns / 1e3, s.p90_ns / 1e3,
+            s.p99_ns / 1e3, s.p999_ns / 1e3, s.max_ns / 1e3
+        );
+    }
+    return out;
+}  // LatencyRecorder::dumpText
+
+auto LatencyRecorder::dumpJson() -> std::string
+{
+    auto out = std::string("{\"unit\": \"ns\", \"operations\": {");
+    auto first = true;
+    for (size_t i = 0; i < OPERATION_COUNT; ++i)
+    {
+        const auto op = static_cast<Operation>(i);
+        const auto s = summary(op);
+        if (s.count == 0) continue;
+
+        out += format(
+            "%s\n  \"%s\": {\"count\": %llu, \"min\": %.1f, \"mean\": %.1f, "
+            "\"p50\": %.1f, \"p90\": %.1f, \"p99\": %.1f, \"p999\": %.1f, "
+            "\"max\": %.1f, \"buckets\": [",
+            first ? "" : ",", operationName(op).data(),
+            static_cast<unsigned long long>(s.count), s.min_ns, s.mean_ns,
+            s.p50_ns, s.p90_ns, s.p99_ns, s.p999_ns, s.max_ns
+        );
+        first = false;
+
+        // Non-empty buckets as [upper bound, count] pairs.
+        const auto& h = state().histograms[i];
+        auto first_bucket = true;
+        for (size_t b = 0; b < h.buckets.size(); ++b)
+        {
+            const auto n = h.buckets[b].load(std::memory_order_relaxed);
+            if (n == 0) continue;
+            const auto [low, width] = bucket_range(b);
+            out += format(
+                "%s[%.1f, %llu]", first_bucket ? "" : ", ",
+                to_ns(low + width - 1), static_cast<unsigned long long>(n)
+            );
+            first_bucket = false;
+        }
+        out += "]}";
+    }
+    out += "\n}}\n";
+    return out;
+}  // LatencyRecorder::dumpJson
+
+auto LatencyRecorder::ticks() noexcept -> uint64_t
+{
+#ifdef VIPER25519_HAS_TSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count()
+    );
+#endif
+}  // LatencyRecorder::ticks
+
+LatencyScope::LatencyScope(Operation op) noexcept
+    : op_{op}, active_{LatencyRecorder::enabled()}
+{
+    if (this->active_) this->start_ = LatencyRecorder::ticks();
+}  // LatencyScope::LatencyScope
+
+LatencyScope::~LatencyScope()
+{
+    if (this->active_)
+        LatencyRecorder::record(
+            this->op_, LatencyRecorder::ticks() - this->start_
+        );
+}  // LatencyScope::~LatencyScope
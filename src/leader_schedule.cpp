@@ -0,0 +1,106 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <algorithm>
+
+// Third-party headers
+#include <botan/hash.h>
+
+// Public Viper25519 Headers
+#include <viper25519/leader_schedule.hpp>
+
+using namespace ed25519;
+
+auto ed25519::praosSlotInput(
+    uint64_t slot, std::span<const uint8_t, 32> epochNonce
+) -> std::array<uint8_t, 32>
+{
+    auto slot_bytes = std::array<uint8_t, 8>{};
+    for (size_t i = 0; i < slot_bytes.size(); ++i)
+        slot_bytes[i] = static_cast<uint8_t>(slot >> (56 - 8 * i));
+
+    auto input = std::array<uint8_t, 32>{};
+    const auto blake2b = Botan::HashFunction::create_or_throw("BLAKE2b(256)");
+    blake2b->update(slot_bytes.data(), slot_bytes.size());
+    blake2b->update(epochNonce.data(), epochNonce.size());
+    blake2b->final(input.data());
+    return input;
+}  // praosSlotInput
+
+LeaderScheduler::LeaderScheduler()
+    : owned_pool_{std::make_unique<ThreadPool>()}, pool_{owned_pool_.get()}
+{
+}  // LeaderScheduler::LeaderScheduler
+
+LeaderScheduler::LeaderScheduler(ThreadPool& pool) : pool_{&pool}
+{
+}  // LeaderScheduler::LeaderScheduler
+
+LeaderScheduler::~LeaderScheduler() = default;
+
+auto LeaderScheduler::compute(
+    const PreparedVRFSecretKey& key,
+    const SlotInput& input,
+    const LeaderPredicate& isLeader,
+    Options options
+) -> std::vector<LeaderSlot>
+{
+    const auto chunk =
+        static_cast<uint64_t>(std::max<size_t>(options.chunkSize, 1));
+    const auto chunks = (options.slotCount + chunk - 1) / chunk;
+
+    // Every chunk collects its own winners so the workers share nothing.
+    auto winners = std::vector<std::vector<LeaderSlot>>(chunks);
+    this->pool_->parallelFor(
+        static_cast<size_t>(chunks),
+        [&](size_t index)
+        {
+            const auto first = options.firstSlot + chunk * index;
+            const auto count = std::min(
+                chunk, options.firstSlot + options.slotCount - first
+            );
+
+            auto inputs = std::vector<std::vector<uint8_t>>();
+            inputs.reserve(count);
+            for (uint64_t i = 0; i < count; ++i)
+                inputs.push_back(input(first + i));
+            const auto msgs = std::vector<std::span<const uint8_t>>(
+                inputs.begin(), inputs.end()
+            );
+
+            // Most slots are not won, so only their hashes are computed and
+            // proofs are made for the winners alone.
+            const auto hashes = key.hashBatch(msgs, options.suite);
+            for (uint64_t i = 0; i < count; ++i)
+            {
+                if (!isLeader(first + i, hashes[i])) continue;
+                const auto proof = key.constructProof(msgs[i], options.suite);
+                winners[index].push_back({first + i, proof, hashes[i]});
+            }
+        }
+    );
+
+    // The chunks are in slot order.
+    auto schedule = std::vector<LeaderSlot>();
+    for (auto& part : winners)
+        schedule.insert(schedule.end(), part.begin(), part.end());
+    return schedule;
+}  // LeaderScheduler::compute
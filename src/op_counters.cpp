@@ -0,0 +1,56 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Public Viper25519 Headers
+#include <viper25519/op_counters.hpp>
+
+// Private Viper25519 code
+#include "instrumentation.hpp"
+
+using namespace ed25519;
+
+#ifdef VIPER25519_OPCOUNT
+thread_local OpCounts ed25519::detail::thread_op_counts{};
+#endif
+
+auto OpCounters::enabled() noexcept -> bool
+{
+#ifdef VIPER25519_OPCOUNT
+    return true;
+#else
+    return false;
+#endif
+}  // OpCounters::enabled
+
+auto OpCounters::snapshot() noexcept -> OpCounts
+{
+#ifdef VIPER25519_OPCOUNT
+    return detail::thread_op_counts;
+#else
+    return {};
+#endif
+}  // OpCounters::snapshot
+
+auto OpCounters::reset() noexcept -> void
+{
+#ifdef VIPER25519_OPCOUNT
+    detail::thread_op_counts = {};
+#endif
+}  // OpCounters::reset
@@ -0,0 +1,247 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <array>
+#include <atomic>
+#include <utility>
+
+#if defined(VIPER25519_PERF_COUNTERS) && defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define VIPER25519_HAS_PERF_EVENT 1
+#endif
+
+// Public Viper25519 Headers
+#include <viper25519/perf_counters.hpp>
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+/// Number of hardware events read per operation.
+constexpr size_t EVENT_COUNT = 4;
+
+using Counts = std::array<uint64_t, EVENT_COUNT>;
+
+/// Running totals of one operation: the call count followed by the events.
+using Totals = std::array<std::atomic<uint64_t>, EVENT_COUNT + 1>;
+
+/// Backing state of the counters, never destroyed (see instrumentation.hpp).
+struct PerfState
+{
+    std::array<Totals, OPERATION_COUNT> totals{};
+    std::atomic<bool> enabled{false};
+};
+
+auto state() -> PerfState&
+{
+    static auto* s = new PerfState();
+    return *s;
+}  // state
+
+#ifdef VIPER25519_HAS_PERF_EVENT
+
+/// The counter group of one thread. It is opened on first use and read with
+/// a single system call. Events the processor or kernel refuse are left out
+/// of the group and read as zero.
+class ThreadCounters
+{
+  private:
+    int leader_ = -1;
+    std::array<int, EVENT_COUNT> fds_{-1, -1, -1, -1};
+    // Position of each event in the group read, or -1 if not opened.
+    std::array<int, EVENT_COUNT> slots_{-1, -1, -1, -1};
+    int opened_ = 0;
+    bool tried_ = false;
+
+    static auto open_event(uint32_t type, uint64_t config, int group) -> int
+    {
+        auto attr = perf_event_attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        // The leader starts disabled and enables the whole group at once.
+        if (group < 0) attr.disabled = 1;
+        return static_cast<int>(
+            ::syscall(SYS_perf_event_open, &attr, 0, -1, group, 0)
+        );
+    }
+
+    auto open() -> void
+    {
+        this->tried_ = true;
+
+        constexpr auto l1d_read_miss =
+            uint64_t{PERF_COUNT_HW_CACHE_L1D} |
+            (uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) |
+            (uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+        constexpr auto events = std::array<std::pair<uint32_t, uint64_t>, 4>{
+            {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+             {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+             {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+             {PERF_TYPE_HW_CACHE, l1d_read_miss}}
+        };
+
+        // Cycles lead the group; without them nothing is measured.
+        for (size_t i = 0; i < EVENT_COUNT; ++i)
+        {
+            const auto fd =
+                open_event(events[i].first, events[i].second, this->leader_);
+            if (fd < 0)
+            {
+                if (i == 0) return;
+                continue;
+            }
+            if (i == 0) this->leader_ = fd;
+            this->fds_[i] = fd;
+            this->slots_[i] = this->opened_++;
+        }
+
+        ::ioctl(this->leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ::ioctl(this->leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+  public:
+    ThreadCounters() = default;
+
+    ~ThreadCounters()
+    {
+        for (const auto fd : this->fds_)
+            if (fd >= 0) ::close(fd);
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    auto operator=(const ThreadCounters&) -> ThreadCounters& = delete;
+
+    auto available() -> bool
+    {
+        if (!this->tried_) this->open();
+        return this->leader_ >= 0;
+    }
+
+    auto read(Counts& out) -> bool
+    {
+        if (!this->available()) return false;
+
+        // PERF_FORMAT_GROUP layout: the number of events, then the values.
+        auto buf = std::array<uint64_t, EVENT_COUNT + 1>{};
+        const auto want =
+            static_cast<ssize_t>(sizeof(uint64_t)) * (this->opened_ + 1);
+        if (::read(this->leader_, buf.data(), sizeof(buf)) != want)
+            return false;
+
+        for (size_t i = 0; i < EVENT_COUNT; ++i)
+        {
+            const auto slot = this->slots_[i];
+            out[i] = slot < 0 ? 0 : buf[static_cast<size_t>(slot) + 1];
+        }
+        return true;
+    }
+
+};  // ThreadCounters
+
+auto thread_counters() -> ThreadCounters&
+{
+    thread_local auto counters = ThreadCounters();
+    return counters;
+}  // thread_counters
+
+auto read_counters(Counts& out) noexcept -> bool
+{
+    return thread_counters().read(out);
+}  // read_counters
+
+auto counters_available() noexcept -> bool
+{
+    return thread_counters().available();
+}  // counters_available
+
+#else
+
+auto read_counters(Counts&) noexcept -> bool
+{
+    return false;
+}  // read_counters
+
+auto counters_available() noexcept -> bool
+{
+    return false;
+}  // counters_available
+
+#endif  // VIPER25519_HAS_PERF_EVENT
+
+}  // unnamed namespace
+
+auto PerfCounters::available() noexcept -> bool
+{
+    return counters_available();
+}  // PerfCounters::available
+
+auto PerfCounters::setEnabled(bool enabled) noexcept -> void
+{
+    state().enabled.store(enabled, std::memory_order_relaxed);
+}  // PerfCounters::setEnabled
+
+auto PerfCounters::enabled() noexcept -> bool
+{
+    return state().enabled.load(std::memory_order_relaxed);
+}  // PerfCounters::enabled
+
+auto PerfCounters::stats(Operation op) noexcept -> PerfCounterStats
+{
+    const auto& t = state().totals[static_cast<size_t>(op)];
+    auto load = [&t](size_t i)
+    { return t[i].load(std::memory_order_relaxed); };
+    return {load(0), load(1), load(2), load(3), load(4)};
+}  // PerfCounters::stats
+
+auto PerfCounters::reset() noexcept -> void
+{
+    for (auto& totals : state().totals)
+        for (auto& value : totals) value.store(0, std::memory_order_relaxed);
+}  // PerfCounters::reset
+
+PerfScope::PerfScope(Operation op) noexcept : op_{op}
+{
+    if (PerfCounters::enabled()) this->active_ = read_counters(this->start_);
+}  // PerfScope::PerfScope
+
+PerfScope::~PerfScope()
+{
+    auto end = Counts{};
+    if (!this->active_ || !read_counters(end)) return;
+
+    auto& totals = state().totals[static_cast<size_t>(this->op_)];
+    totals[0].fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < EVENT_COUNT; ++i)
+    {
+        totals[i + 1].fetch_add(
+            end[i] - this->start_[i], std::memory_order_relaxed
+        );
+    }
+}  // PerfScope::~PerfScope
@@ -0,0 +1,265 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// Public Viper25519 Headers
+#include <viper25519/point_cache.hpp>
+
+// Private Viper25519 Headers
+#include "random.hpp"
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+using Key = std::array<uint8_t, 32>;
+
+/// SipHash-2-4 of a public key under a key drawn once per process. The keys
+/// looked up are chosen by whoever supplies the signatures, so an unkeyed
+/// hash would let them flood a single bucket or shard.
+struct KeyHash
+{
+    std::array<uint64_t, 2> k{};
+
+    auto operator()(const Key& key) const noexcept -> size_t
+    {
+        auto v0 = this->k[0] ^ 0x736f6d6570736575ULL;
+        auto v1 = this->k[1] ^ 0x646f72616e646f6dULL;
+        auto v2 = this->k[0] ^ 0x6c7967656e657261ULL;
+        auto v3 = this->k[1] ^ 0x7465646279746573ULL;
+        const auto round = [&]
+        {
+            v0 += v1;
+            v1 = std::rotl(v1, 13) ^ v0;
+            v0 = std::rotl(v0, 32);
+            v2 += v3;
+            v3 = std::rotl(v3, 16) ^ v2;
+            v0 += v3;
+            v3 = std::rotl(v3, 21) ^ v0;
+            v2 += v1;
+            v1 = std::rotl(v1, 17) ^ v2;
+            v2 = std::rotl(v2, 32);
+        };
+        const auto compress = [&](uint64_t m)
+        {
+            v3 ^= m;
+            round();
+            round();
+            v0 ^= m;
+        };
+
+        for (size_t i = 0; i < key.size(); i += 8)
+        {
+            auto m = uint64_t{0};
+            for (size_t j = 0; j < 8; ++j)
+                m |= static_cast<uint64_t>(key[i + j]) << (8 * j);
+            compress(m);
+        }
+        compress(static_cast<uint64_t>(key.size()) << 56);
+
+        v2 ^= 0xff;
+        for (auto i = 0; i < 4; ++i) round();
+        return static_cast<size_t>(v0 ^ v1 ^ v2 ^ v3);
+    }
+};
+
+/// Return a hasher with a fresh random key.
+auto random_key_hash() -> KeyHash
+{
+    auto bytes = std::array<uint8_t, 16>{};
+    ChaCha20Rng::local().randomize(bytes);
+    auto hash = KeyHash{};
+    std::memcpy(hash.k.data(), bytes.data(), bytes.size());
+    return hash;
+}  // random_key_hash
+
+/// One independently locked part of the cache. Entries are kept in a list
+/// ordered from the next to be evicted to the last, with an index into the
+/// list for lookups.
+struct Shard
+{
+    using Entry = std::pair<Key, curve25519::ExtendedPoint>;
+    using Index = std::unordered_map<Key, std::list<Entry>::iterator, KeyHash>;
+
+    std::mutex mutex;
+    std::list<Entry> entries;
+    Index index;
+    size_t capacity = 0;
+    EvictionPolicy policy = EvictionPolicy::Lru;
+
+    auto clear() -> void
+    {
+        this->index.clear();
+        this->entries.clear();
+    }
+};
+
+/// Backing state of the cache. Like the secure arena it is never destroyed so
+/// that verification during program exit remains safe.
+struct CacheState
+{
+    KeyHash hash = random_key_hash();
+    std::array<Shard, PointCache::SHARD_COUNT> shards;
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+
+    CacheState()
+    {
+        for (auto& shard : this->shards)
+            shard.index = Shard::Index(0, this->hash);
+    }
+};
+
+auto state() -> CacheState&
+{
+    static auto* s = new CacheState();
+    return *s;
+}  // state
+
+auto shard_for(size_t hash) -> Shard&
+{
+    // Use the high byte so the shard choice is independent of the bucket
+    // chosen by the index within the shard.
+    constexpr auto shift = sizeof(size_t) * 8 - 8;
+    return state().shards[(hash >> shift) % PointCache::SHARD_COUNT];
+}  // shard_for
+
+}  // unnamed namespace
+
+auto PointCache::configure(size_t capacity, EvictionPolicy policy) -> void
+{
+    auto& s = state();
+    s.enabled.store(false, std::memory_order_relaxed);
+
+    const auto per_shard = (capacity + SHARD_COUNT - 1) / SHARD_COUNT;
+    for (auto& shard : s.shards)
+    {
+        const auto lock = std::lock_guard(shard.mutex);
+        shard.clear();
+        shard.capacity = per_shard;
+        shard.policy = policy;
+    }
+
+    PointCache::resetStats();
+    s.enabled.store(capacity > 0, std::memory_order_release);
+}  // PointCache::configure
+
+auto PointCache::enabled() noexcept -> bool
+{
+    return state().enabled.load(std::memory_order_acquire);
+}  // PointCache::enabled
+
+auto PointCache::clear() -> void
+{
+    for (auto& shard : state().shards)
+    {
+        const auto lock = std::lock_guard(shard.mutex);
+        shard.clear();
+    }
+}  // PointCache::clear
+
+auto PointCache::stats() -> PointCacheStats
+{
+    auto& s = state();
+    auto res = PointCacheStats{
+        s.hits.load(std::memory_order_relaxed),
+        s.misses.load(std::memory_order_relaxed), 0};
+    for (auto& shard : s.shards)
+    {
+        const auto lock = std::lock_guard(shard.mutex);
+        res.size += shard.entries.size();
+    }
+    return res;
+}  // PointCache::stats
+
+auto PointCache::resetStats() noexcept -> void
+{
+    state().hits.store(0, std::memory_order_relaxed);
+    state().misses.store(0, std::memory_order_relaxed);
+}  // PointCache::resetStats
+
+auto PointCache::unpack(std::span<const uint8_t, 32> key) noexcept
+    -> std::optional<curve25519::ExtendedPoint>
+{
+    if (!PointCache::enabled())
+        return curve25519::ExtendedPoint::tryUnpack(key);
+
+    auto k = Key{};
+    std::copy(key.begin(), key.end(), k.begin());
+    const auto hash = state().hash(k);
+    auto& shard = shard_for(hash);
+    auto& s = state();
+
+    try
+    {
+        {
+            const auto lock = std::lock_guard(shard.mutex);
+            const auto it = shard.index.find(k);
+            if (it != shard.index.end())
+            {
+                if (shard.policy == EvictionPolicy::Lru)
+                    shard.entries.splice(
+                        shard.entries.end(), shard.entries, it->second
+                    );
+                s.hits.fetch_add(1, std::memory_order_relaxed);
+                return it->second->second;
+            }
+        }
+        s.misses.fetch_add(1, std::memory_order_relaxed);
+
+        // Decode outside of the lock, the square root dominates the cost.
+        const auto p = curve25519::ExtendedPoint::tryUnpack(key);
+        if (!p) return std::nullopt;
+
+        const auto lock = std::lock_guard(shard.mutex);
+        if (shard.capacity == 0 || shard.index.contains(k)) return p;
+        if (shard.entries.size() >= shard.capacity)
+        {
+            shard.index.erase(shard.entries.front().first);
+            shard.entries.pop_front();
+        }
+        shard.entries.emplace_back(k, *p);
+        try
+        {
+            shard.index.emplace(k, std::prev(shard.entries.end()));
+        }
+        catch (...)
+        {
+            shard.entries.pop_back();
+        }
+        return p;
+    }
+    catch (...)
+    {
+        // Locking or allocation failed, fall back to decoding directly.
+        return curve25519::ExtendedPoint::tryUnpack(key);
+    }
+}  // PointCache::unpack
@@ -0,0 +1,195 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <pthread.h>
+#include <sys/random.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <stdexcept>
+
+// Public Viper25519 Headers
+#include <viper25519/ed25519.hpp>
+
+// Private Viper25519 code
+#include "random.hpp"
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+/// Incremented in the child after a fork and on an explicit reseed. Every
+/// generator compares it with the value seen at its last seeding.
+std::atomic<uint64_t> rng_generation{1};
+
+auto register_fork_handler() -> bool
+{
+    return pthread_atfork(
+               nullptr, nullptr,
+               []() { rng_generation.fetch_add(1, std::memory_order_relaxed); }
+           ) == 0;
+}  // register_fork_handler
+
+const auto fork_handler_registered = register_fork_handler();
+
+constexpr auto rotl(uint32_t v, int c) -> uint32_t
+{
+    return (v << c) | (v >> (32 - c));
+}  // rotl
+
+constexpr auto load32_le(const uint8_t* p) -> uint32_t
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) |
+           (static_cast<uint32_t>(p[3]) << 24);
+}  // load32_le
+
+constexpr auto quarter_round(
+    std::array<uint32_t, 16>& x, size_t a, size_t b, size_t c, size_t d
+) -> void
+{
+    x[a] += x[b];
+    x[d] = rotl(x[d] ^ x[a], 16);
+    x[c] += x[d];
+    x[b] = rotl(x[b] ^ x[c], 12);
+    x[a] += x[b];
+    x[d] = rotl(x[d] ^ x[a], 8);
+    x[c] += x[d];
+    x[b] = rotl(x[b] ^ x[c], 7);
+}  // quarter_round
+
+/// Fill the buffer with bytes from the operating system.
+auto os_random(std::span<uint8_t> out) -> void
+{
+    while (!out.empty())
+    {
+        const auto n = getrandom(out.data(), out.size(), 0);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("RNG error");
+        }
+        out = out.subspan(static_cast<size_t>(n));
+    }
+}  // os_random
+
+}  // unnamed namespace
+
+auto ed25519::chacha20_block(
+    std::span<const uint8_t, 32> key,
+    uint32_t counter,
+    std::span<const uint8_t, 12> nonce
+) -> std::array<uint8_t, 64>
+{
+    auto state = std::array<uint32_t, 16>{
+        0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+    for (size_t i = 0; i < 8; ++i) state[4 + i] = load32_le(&key[4 * i]);
+    state[12] = counter;
+    for (size_t i = 0; i < 3; ++i) state[13 + i] = load32_le(&nonce[4 * i]);
+
+    auto x = state;
+    for (auto i = 0; i < 10; ++i)
+    {
+        quarter_round(x, 0, 4, 8, 12);
+        quarter_round(x, 1, 5, 9, 13);
+        quarter_round(x, 2, 6, 10, 14);
+        quarter_round(x, 3, 7, 11, 15);
+        quarter_round(x, 0, 5, 10, 15);
+        quarter_round(x, 1, 6, 11, 12);
+        quarter_round(x, 2, 7, 8, 13);
+        quarter_round(x, 3, 4, 9, 14);
+    }
+
+    auto out = std::array<uint8_t, 64>{};
+    for (size_t i = 0; i < 16; ++i)
+    {
+        const auto v = x[i] + state[i];
+        out[4 * i + 0] = static_cast<uint8_t>(v);
+        out[4 * i + 1] = static_cast<uint8_t>(v >> 8);
+        out[4 * i + 2] = static_cast<uint8_t>(v >> 16);
+        out[4 * i + 3] = static_cast<uint8_t>(v >> 24);
+    }
+    std::fill_n<volatile uint32_t*>(x.data(), x.size(), 0);
+    std::fill_n<volatile uint32_t*>(state.data(), state.size(), 0);
+    return out;
+}  // chacha20_block
+
+auto ChaCha20Rng::local() -> ChaCha20Rng&
+{
+    thread_local auto rng = ChaCha20Rng();
+    return rng;
+}  // ChaCha20Rng::local
+
+auto ChaCha20Rng::reseed() -> void
+{
+    os_random(this->key_);
+    std::fill_n<volatile uint8_t*>(this->buffer_.data(), BUFFER_SIZE, 0);
+    this->pos_ = BUFFER_SIZE;
+    this->since_reseed_ = 0;
+    this->generation_ = rng_generation.load(std::memory_order_relaxed);
+    this->seeded_ = true;
+}  // ChaCha20Rng::reseed
+
+auto ChaCha20Rng::refill() -> void
+{
+    // The output blocks and the next key are all derived from the current
+    // key. Replacing the key afterwards means earlier output cannot be
+    // recovered from the generator state (fast key erasure).
+    static constexpr auto nonce = std::array<uint8_t, 12>{};
+    for (uint32_t i = 0; i < BUFFER_SIZE / 64; ++i)
+    {
+        const auto out = chacha20_block(this->key_, i + 1, nonce);
+        std::copy(out.begin(), out.end(), this->buffer_.begin() + 64 * i);
+    }
+    auto block = chacha20_block(this->key_, 0, nonce);
+    std::copy_n(block.begin(), 32, this->key_.begin());
+    std::fill_n<volatile uint8_t*>(block.data(), block.size(), 0);
+    this->pos_ = 0;
+}  // ChaCha20Rng::refill
+
+auto ChaCha20Rng::randomize(std::span<uint8_t> out) -> void
+{
+    if (!this->seeded_ || this->since_reseed_ >= RESEED_INTERVAL ||
+        this->generation_ != rng_generation.load(std::memory_order_relaxed))
+        this->reseed();
+
+    while (!out.empty())
+    {
+        if (this->pos_ == BUFFER_SIZE) this->refill();
+
+        const auto n = std::min(out.size(), BUFFER_SIZE - this->pos_);
+        auto* src = this->buffer_.data() + this->pos_;
+        std::copy_n(src, n, out.begin());
+        std::fill_n<volatile uint8_t*>(src, n, 0);
+        this->pos_ += n;
+        this->since_reseed_ += n;
+        out = out.subspan(n);
+    }
+}  // ChaCha20Rng::randomize
+
+auto ed25519::reseedRandomGenerator() -> void
+{
+    // Force every other thread to reseed on its next draw as well.
+    rng_generation.fetch_add(1, std::memory_order_relaxed);
+    ChaCha20Rng::local().reseed();
+}  // reseedRandomGenerator
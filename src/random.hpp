@@ -0,0 +1,81 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#ifndef VIPER25519_RANDOM_HPP_
+#define VIPER25519_RANDOM_HPP_
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include <viper25519/secmem.hpp>
+
+namespace ed25519
+{
+
+/// Compute a single 64 byte ChaCha20 block (RFC 8439).
+auto chacha20_block(
+    std::span<const uint8_t, 32> key,
+    uint32_t counter,
+    std::span<const uint8_t, 12> nonce
+) -> std::array<uint8_t, 64>;
+
+/// @brief Buffered ChaCha20 random number generator.
+/// Each thread owns a generator that is seeded from the operating system
+/// (getrandom) and then expands the seed with ChaCha20, so drawing key or
+/// nonce material does not require a system call per request. The key is
+/// replaced after every refill (fast key erasure) and bytes are wiped from the
+/// buffer as they are handed out. The generator reseeds from the operating
+/// system periodically, after a fork, and whenever reseed is called.
+class ChaCha20Rng
+{
+  private:
+    static constexpr size_t BUFFER_SIZE = 16 * 64;
+    static constexpr size_t RESEED_INTERVAL = 1024 * 1024;
+
+    SecureByteArray<uint8_t, 32> key_{};
+    SecureByteArray<uint8_t, BUFFER_SIZE> buffer_{};
+    size_t pos_ = BUFFER_SIZE;
+    size_t since_reseed_ = 0;
+    uint64_t generation_ = 0;
+    bool seeded_ = false;
+
+    ChaCha20Rng() = default;
+
+    auto refill() -> void;
+
+  public:
+    ChaCha20Rng(const ChaCha20Rng&) = delete;
+    auto operator=(const ChaCha20Rng&) -> ChaCha20Rng& = delete;
+
+    /// @brief Return the generator owned by the calling thread.
+    [[nodiscard]] static auto local() -> ChaCha20Rng&;
+
+    /// @brief Fill a buffer with random bytes.
+    auto randomize(std::span<uint8_t> out) -> void;
+
+    /// @brief Discard the current state and reseed from the operating system.
+    auto reseed() -> void;
+
+};  // ChaCha20Rng
+
+}  // namespace ed25519
+
+#endif  // VIPER25519_RANDOM_HPP_
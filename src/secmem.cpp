@@ -0,0 +1,250 @@
+// Copyright (c) 2022 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+// Public Viper25519 Headers
+#include <viper25519/secmem.hpp>
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+constexpr auto WORD_BITS = size_t{64};
+static_assert(SecureArena::SLOT_COUNT % WORD_BITS == 0);
+
+/// One mlocked region of slots surrounded by guard pages.
+struct Region
+{
+    uint8_t* slots = nullptr;
+    size_t region_size = 0;
+    size_t word_count = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> used;
+    std::atomic<size_t> free_slots{0};
+    std::atomic<size_t> next_word{0};
+
+    explicit Region(size_t slot_count)
+    {
+        const auto page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const auto bytes = slot_count * SecureArena::SLOT_SIZE;
+        region_size = ((bytes + page - 1) / page) * page;
+
+        // Reserve the region plus one guard page on either side. Only the
+        // interior is made accessible.
+        auto* base = mmap(
+            nullptr, region_size + 2 * page, PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+        );
+        if (base == MAP_FAILED) return;
+
+        auto* region = static_cast<uint8_t*>(base) + page;
+        if (mprotect(region, region_size, PROT_READ | PROT_WRITE) != 0)
+        {
+            munmap(base, region_size + 2 * page);
+            return;
+        }
+
+        // A failure to lock the region (e.g. RLIMIT_MEMLOCK is too low) still
+        // leaves a usable arena, just as a failed mlock did for the original
+        // per-object implementation.
+        mlock(region, region_size);
+#if defined(MADV_DONTDUMP)
+        madvise(region, region_size, MADV_DONTDUMP);
+#endif
+        word_count = slot_count / WORD_BITS;
+        used = std::make_unique<std::atomic<uint64_t>[]>(word_count);
+        free_slots.store(slot_count, std::memory_order_relaxed);
+        slots = region;
+    }
+
+    auto contains(const void* p) const -> bool
+    {
+        const auto* b = static_cast<const uint8_t*>(p);
+        return slots != nullptr && b >= slots && b < slots + region_size;
+    }
+
+    /// Claim a free slot, or return nullptr if the region is full.
+    auto tryAllocate() -> void*
+    {
+        // Reserve a slot first so that full regions, which make up most of a
+        // large arena, are skipped without searching their bitmaps.
+        auto available = free_slots.load(std::memory_order_relaxed);
+        do
+        {
+            if (available == 0) return nullptr;
+        } while (!free_slots.compare_exchange_weak(
+            available, available - 1, std::memory_order_relaxed
+        ));
+
+        // A reserved slot is free somewhere in the bitmap. Start the search
+        // at a rotating word to spread concurrent callers across it.
+        auto w = next_word.fetch_add(1, std::memory_order_relaxed);
+        for (;; ++w)
+        {
+            auto& word = used[w % word_count];
+            auto bits = word.load(std::memory_order_relaxed);
+            while (bits != ~uint64_t{0})
+            {
+                const auto bit = static_cast<size_t>(std::countr_one(bits));
+                if (word.compare_exchange_weak(
+                        bits, bits | (uint64_t{1} << bit),
+                        std::memory_order_acquire, std::memory_order_relaxed
+                    ))
+                {
+                    const auto index = ((w % word_count) * WORD_BITS) + bit;
+                    return slots + index * SecureArena::SLOT_SIZE;
+                }
+            }
+        }
+    }
+
+    auto release(void* p) -> void
+    {
+        const auto index =
+            static_cast<size_t>(static_cast<uint8_t*>(p) - slots) /
+            SecureArena::SLOT_SIZE;
+        used[index / WORD_BITS].fetch_and(
+            ~(uint64_t{1} << (index % WORD_BITS)), std::memory_order_release
+        );
+        free_slots.fetch_add(1, std::memory_order_release);
+    }
+};  // Region
+
+/// Backing state of the secure arena. The regions are added as they fill up
+/// and, like the state itself, are intentionally never destroyed so that key
+/// objects with static storage duration may still be released safely during
+/// program exit.
+struct ArenaState
+{
+    std::array<std::atomic<Region*>, SecureArena::MAX_REGIONS> regions{};
+    std::atomic<size_t> region_count{0};
+    std::mutex grow_mutex;
+    std::atomic<size_t> in_use{0};
+
+    /// Add a region unless another thread already did so since count was
+    /// read. Return false if no further region can be created.
+    auto grow(size_t count) -> bool
+    {
+        // Region n holds SLOT_COUNT << n slots, which must be addressable.
+        constexpr auto max_shift = static_cast<size_t>(
+            std::numeric_limits<size_t>::digits -
+            std::bit_width(SecureArena::SLOT_COUNT * SecureArena::SLOT_SIZE)
+        );
+
+        const auto lock = std::lock_guard(grow_mutex);
+        const auto current = region_count.load(std::memory_order_acquire);
+        if (current != count) return true;
+        if (current == regions.size() || current >= max_shift) return false;
+
+        auto* region = new Region(SecureArena::SLOT_COUNT << current);
+        if (region->slots == nullptr)
+        {
+            delete region;
+            return false;
+        }
+        regions[current].store(region, std::memory_order_release);
+        region_count.store(current + 1, std::memory_order_release);
+        return true;
+    }
+
+    auto find(const void* p) const -> Region*
+    {
+        const auto count = region_count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto* region = regions[i].load(std::memory_order_acquire);
+            if (region->contains(p)) return region;
+        }
+        return nullptr;
+    }
+};  // ArenaState
+
+auto arena() -> ArenaState&
+{
+    static auto* state = new ArenaState();
+    return *state;
+}  // arena
+
+auto wipe(void* p, size_t size) -> void
+{
+    std::fill_n<volatile uint8_t*>(static_cast<uint8_t*>(p), size, 0);
+}  // wipe
+
+}  // unnamed namespace
+
+auto SecureArena::allocate(size_t size) -> void*
+{
+    auto& state = arena();
+    while (size <= SLOT_SIZE)
+    {
+        const auto count = state.region_count.load(std::memory_order_acquire);
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto* region = state.regions[i].load(std::memory_order_acquire);
+            if (auto* p = region->tryAllocate())
+            {
+                state.in_use.fetch_add(1, std::memory_order_relaxed);
+                return p;
+            }
+        }
+
+        // Every region is full, add another one.
+        if (!state.grow(count)) break;
+    }
+
+    // The request is larger than a slot or no region can be added, fall back
+    // to locking the allocation individually.
+    auto* p = new uint8_t[size]();
+    mlock(p, size);
+    return p;
+}  // SecureArena::allocate
+
+auto SecureArena::deallocate(void* p, size_t size) -> void
+{
+    if (p == nullptr) return;
+    wipe(p, size);
+
+    auto& state = arena();
+    if (auto* region = state.find(p))
+    {
+        region->release(p);
+        state.in_use.fetch_sub(1, std::memory_order_relaxed);
+        return;
+    }
+
+    munlock(p, size);
+    delete[] static_cast<uint8_t*>(p);
+}  // SecureArena::deallocate
+
+auto SecureArena::slotsInUse() -> size_t
+{
+    return arena().in_use.load(std::memory_order_relaxed);
+}  // SecureArena::slotsInUse
@@ -0,0 +1,267 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// Third-Party Library Headers
+#include <botan/hash.h>
+
+// Public Viper25519 Headers
+#include <viper25519/signature_cache.hpp>
+
+// Private Viper25519 code
+#include "random.hpp"
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+/// Number of consecutive slots searched for a fingerprint.
+constexpr size_t PROBE_LENGTH = 4;
+
+/// Open addressing table of 128 bit fingerprints. Each entry is stored as two
+/// 64 bit words, zero marking an empty slot. Readers may observe the two words
+/// of an entry from different writes, but a lookup only succeeds if both
+/// words match the same fingerprint, which was then inserted as valid.
+struct Table
+{
+    size_t mask = 0;
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    std::array<uint8_t, 32> salt{};
+
+    explicit Table(size_t entries)
+        : mask{entries - 1},
+          words{std::make_unique<std::atomic<uint64_t>[]>(2 * entries)}
+    {
+        ChaCha20Rng::local().randomize(this->salt);
+    }
+};
+
+/// The table is replaced with a simple two epoch scheme. Readers register in
+/// the counter of the current epoch before loading the table pointer, so the
+/// count never lives in memory that may be freed, and retry if the epoch
+/// moved while they registered. configure swaps the table, moves to the other
+/// epoch and waits for the readers of the previous epoch. Every reader that
+/// may hold the old table registered in that epoch, and since configure runs
+/// under a mutex no later call can free a table before those readers are
+/// done. Readers arriving meanwhile use the other counter, so configure
+/// cannot be starved.
+struct CacheState
+{
+    std::mutex config_mutex;
+    std::atomic<Table*> table{nullptr};
+    std::atomic<size_t> epoch{0};
+    std::array<std::atomic<size_t>, 2> readers{};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
+auto state() -> CacheState&
+{
+    static auto* s = new CacheState();
+    return *s;
+}  // state
+
+/// Reference to the current table that keeps it alive while in use. A table
+/// replaced by configure is only freed once its readers have finished.
+class TableRef
+{
+  private:
+    std::atomic<size_t>* readers_ = nullptr;
+    Table* table_ = nullptr;
+
+  public:
+    TableRef()
+    {
+        auto& s = state();
+        for (;;)
+        {
+            const auto epoch = s.epoch.load();
+            this->readers_ = &s.readers[epoch & 1];
+            this->readers_->fetch_add(1);
+            if (s.epoch.load() == epoch) break;
+
+            // A configure may already have waited on this counter.
+            this->readers_->fetch_sub(1);
+        }
+        this->table_ = s.table.load();
+    }
+    ~TableRef() { this->readers_->fetch_sub(1); }
+    TableRef(const TableRef&) = delete;
+    auto operator=(const TableRef&) -> TableRef& = delete;
+
+    auto operator*() const -> Table& { return *this->table_; }
+    auto operator->() const -> Table* { return this->table_; }
+    explicit operator bool() const { return this->table_ != nullptr; }
+};
+
+struct Fingerprint
+{
+    uint64_t lo;
+    uint64_t hi;
+};
+
+auto fingerprint(
+    const Table& table,
+    std::span<const uint8_t, 64> hram,
+    std::span<const uint8_t, 32> s,
+    VerifyMode mode
+) -> Fingerprint
+{
+    static thread_local const auto sha512 =
+        Botan::HashFunction::create_or_throw("SHA-512");
+    sha512->update(table.salt.data(), table.salt.size());
+    sha512->update(static_cast<uint8_t>(mode));
+    sha512->update(hram.data(), hram.size());
+    sha512->update(s.data(), s.size());
+    auto digest = std::array<uint8_t, 64>{};
+    sha512->final(digest.data());
+
+    auto fp = Fingerprint{};
+    std::memcpy(&fp.lo, digest.data(), sizeof(fp.lo));
+    std::memcpy(&fp.hi, digest.data() + 8, sizeof(fp.hi));
+    fp.lo |= 1;  // never equal to an empty slot
+    return fp;
+}  // fingerprint
+
+}  // unnamed namespace
+
+auto SignatureCache::configure(size_t bytes) -> void
+{
+    auto& s = state();
+    const auto lock = std::lock_guard(s.config_mutex);
+
+    auto* next = static_cast<Table*>(nullptr);
+    if (bytes >= ENTRY_SIZE * PROBE_LENGTH)
+        next = new Table(std::bit_floor(bytes / ENTRY_SIZE));
+
+    auto* prev = s.table.exchange(next);
+    if (prev)
+    {
+        // Anyone that loaded prev registered in the epoch being left.
+        const auto old_epoch = s.epoch.fetch_add(1);
+        while (s.readers[old_epoch & 1].load() != 0) std::this_thread::yield();
+        delete prev;
+    }
+    SignatureCache::resetStats();
+}  // SignatureCache::configure
+
+auto SignatureCache::enabled() noexcept -> bool
+{
+    return state().table.load(std::memory_order_relaxed) != nullptr;
+}  // SignatureCache::enabled
+
+auto SignatureCache::clear() noexcept -> void
+{
+    const auto table = TableRef();
+    if (!table) return;
+    for (size_t i = 0; i < 2 * (table->mask + 1); ++i)
+        table->words[i].store(0, std::memory_order_relaxed);
+}  // SignatureCache::clear
+
+auto SignatureCache::stats() noexcept -> SignatureCacheStats
+{
+    const auto table = TableRef();
+    return {
+        state().hits.load(std::memory_order_relaxed),
+        state().misses.load(std::memory_order_relaxed),
+        table ? table->mask + 1 : 0};
+}  // SignatureCache::stats
+
+auto SignatureCache::resetStats() noexcept -> void
+{
+    state().hits.store(0, std::memory_order_relaxed);
+    state().misses.store(0, std::memory_order_relaxed);
+}  // SignatureCache::resetStats
+
+auto SignatureCache::contains(
+    std::span<const uint8_t, 64> hram,
+    std::span<const uint8_t, 32> s,
+    VerifyMode mode
+) noexcept -> bool
+{
+    const auto table = TableRef();
+    if (!table) return false;
+
+    try
+    {
+        const auto fp = fingerprint(*table, hram, s, mode);
+        for (size_t i = 0; i < PROBE_LENGTH; ++i)
+        {
+            const auto slot = (fp.lo + i) & table->mask;
+            if (table->words[2 * slot].load(std::memory_order_relaxed) ==
+                    fp.lo &&
+                table->words[2 * slot + 1].load(std::memory_order_relaxed) ==
+                    fp.hi)
+            {
+                state().hits.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    catch (...)
+    {
+        // Treat a failure to hash as a miss.
+    }
+    state().misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}  // SignatureCache::contains
+
+auto SignatureCache::insert(
+    std::span<const uint8_t, 64> hram,
+    std::span<const uint8_t, 32> s,
+    VerifyMode mode
+) noexcept -> void
+{
+    const auto table = TableRef();
+    if (!table) return;
+
+    try
+    {
+        const auto fp = fingerprint(*table, hram, s, mode);
+
+        // Use the first empty slot of the probe sequence, otherwise replace
+        // a slot chosen by the fingerprint itself.
+        auto target = (fp.lo + (fp.hi % PROBE_LENGTH)) & table->mask;
+        for (size_t i = 0; i < PROBE_LENGTH; ++i)
+        {
+            const auto slot = (fp.lo + i) & table->mask;
+            if (table->words[2 * slot].load(std::memory_order_relaxed) == 0)
+            {
+                target = slot;
+                break;
+            }
+        }
+        table->words[2 * target].store(fp.lo, std::memory_order_relaxed);
+        table->words[2 * target + 1].store(fp.hi, std::memory_order_relaxed);
+    }
+    catch (...)
+    {
+        // Failing to record an entry only costs a later re-verification.
+    }
+}  // SignatureCache::insert
@@ -0,0 +1,217 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Public Viper25519 Headers
+#include <viper25519/thread_pool.hpp>
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+struct TaskQueue
+{
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+};
+
+/// The pool and queue index of the calling thread, if it is a worker.
+thread_local const void* current_pool = nullptr;
+thread_local size_t current_index = 0;
+
+}  // unnamed namespace
+
+struct ThreadPool::Impl
+{
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex idle_mutex;
+    std::condition_variable idle_cv;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> next{0};
+    bool stop = false;
+
+    auto push(std::function<void()> task) -> void
+    {
+        const auto index = (current_pool == this)
+                               ? current_index
+                               : this->next.fetch_add(1) % this->queues.size();
+        // Count the task before it becomes visible so that the counter never
+        // drops below the number of queued tasks.
+        this->pending.fetch_add(1);
+        try
+        {
+            auto& queue = *this->queues[index];
+            const auto lock = std::lock_guard(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        catch (...)
+        {
+            this->pending.fetch_sub(1);
+            throw;
+        }
+        {
+            // Synchronise with a worker that is about to wait.
+            const auto lock = std::lock_guard(this->idle_mutex);
+        }
+        this->idle_cv.notify_one();
+    }
+
+    /// Run one task, preferring the newest task of the given queue and
+    /// otherwise stealing the oldest task of another queue.
+    auto tryRun(size_t self) -> bool
+    {
+        auto task = std::function<void()>();
+        {
+            auto& own = *this->queues[self];
+            const auto lock = std::lock_guard(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+            }
+        }
+        for (size_t i = 1; !task && i < this->queues.size(); ++i)
+        {
+            auto& other = *this->queues[(self + i) % this->queues.size()];
+            const auto lock = std::lock_guard(other.mutex);
+            if (!other.tasks.empty())
+            {
+                task = std::move(other.tasks.front());
+                other.tasks.pop_front();
+            }
+        }
+        if (!task) return false;
+
+        this->pending.fetch_sub(1);
+        task();
+        return true;
+    }
+
+    auto work(size_t index) -> void
+    {
+        current_pool = this;
+        current_index = index;
+        while (true)
+        {
+            if (this->tryRun(index)) continue;
+            auto lock = std::unique_lock(this->idle_mutex);
+            this->idle_cv.wait(
+                lock,
+                [this] { return this->stop || this->pending.load() > 0; }
+            );
+            if (this->stop && this->pending.load() == 0) return;
+        }
+    }
+};
+
+ThreadPool::ThreadPool(size_t threads) : impl_{std::make_unique<Impl>()}
+{
+    if (threads == 0)
+        threads = std::max(1U, std::thread::hardware_concurrency());
+
+    for (size_t i = 0; i < threads; ++i)
+        this->impl_->queues.push_back(std::make_unique<TaskQueue>());
+    for (size_t i = 0; i < threads; ++i)
+        this->impl_->threads.emplace_back([this, i] { this->impl_->work(i); });
+}  // ThreadPool::ThreadPool
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const auto lock = std::lock_guard(this->impl_->idle_mutex);
+        this->impl_->stop = true;
+    }
+    this->impl_->idle_cv.notify_all();
+    for (auto& thread : this->impl_->threads) thread.join();
+}  // ThreadPool::~ThreadPool
+
+auto ThreadPool::size() const noexcept -> size_t
+{
+    return this->impl_->threads.size();
+}  // ThreadPool::size
+
+auto ThreadPool::submit(std::function<void()> task) -> void
+{
+    this->impl_->push(std::move(task));
+}  // ThreadPool::submit
+
+auto ThreadPool::parallelFor(
+    size_t count, const std::function<void(size_t)>& fn
+) -> void
+{
+    if (count == 0) return;
+
+    auto remaining = std::atomic<size_t>{count};
+    auto error_mutex = std::mutex();
+    auto error = std::exception_ptr();
+
+    // Help with the queued work rather than blocking, which also keeps a
+    // worker calling parallelFor from deadlocking the pool.
+    const auto self = (current_pool == this->impl_.get()) ? current_index : 0;
+    auto wait = [&]
+    {
+        while (remaining.load(std::memory_order_acquire) != 0)
+            if (!this->impl_->tryRun(self)) std::this_thread::yield();
+    };
+
+    auto queued = size_t{0};
+    try
+    {
+        for (; queued < count; ++queued)
+        {
+            this->impl_->push(
+                [&, i = queued]
+                {
+                    try
+                    {
+                        fn(i);
+                    }
+                    catch (...)
+                    {
+                        const auto lock = std::lock_guard(error_mutex);
+                        if (!error) error = std::current_exception();
+                    }
+                    remaining.fetch_sub(1, std::memory_order_release);
+                }
+            );
+        }
+    }
+    catch (...)
+    {
+        // The queued tasks refer to this frame and must finish first.
+        remaining.fetch_sub(count - queued);
+        wait();
+        throw;
+    }
+
+    wait();
+    if (error) std::rethrow_exception(error);
+}  // ThreadPool::parallelFor
@@ -21,6 +21,7 @@
 #ifndef VIPER25519_UTILS_HPP_
 #define VIPER25519_UTILS_HPP_
 
+#include <array>
 #include <cstdint>
 #include <span>
 #include <stdexcept>
@@ -28,6 +29,17 @@
 namespace ed25519
 {
 
+/// Timing safe memory compare of two buffers of the same fixed size.
+template <size_t N>
+constexpr auto mem_verify(
+    std::span<const uint8_t, N> x, std::span<const uint8_t, N> y
+) noexcept -> bool
+{
+    size_t differentbits = 0;
+    for (size_t i = 0; i < N; ++i) differentbits |= (x[i] ^ y[i]);
+    return (bool)(1 & ((differentbits - 1) >> 8));
+}  // mem_verify
+
 /// Timing safe memory compare.
 constexpr auto mem_verify(
     std::span<const uint8_t> x, std::span<const uint8_t> y
@@ -43,6 +55,90 @@ constexpr auto mem_verify(
     return (bool)(1 & ((differentbits - 1) >> 8));
 }  // mem_verify
 
+/// The group order L = 2^252 + 27742317777372353535851937790883648493 as
+/// little endian bytes.
+inline constexpr auto group_order_bytes = std::array<uint8_t, 32>{
+    0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7,
+    0xa2, 0xde, 0xf9, 0xde, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10};
+
+/// Encodings of the points of small order, including the non-canonical
+/// encodings y = p and y = p + 1. The sign bit is ignored when comparing.
+inline constexpr uint8_t small_order_points[7][32] = {
+    // 0 (order 4)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // 1 (order 1)
+    {0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    // order 8
+    {0x26, 0xe8, 0x95, 0x8f, 0xc2, 0xb2, 0x27, 0xb0, 0x45, 0xc3, 0xf4,
+     0x89, 0xf2, 0xef, 0x98, 0xf0, 0xd5, 0xdf, 0xac, 0x05, 0xd3, 0xc6,
+     0x33, 0x39, 0xb1, 0x38, 0x02, 0x88, 0x6d, 0x53, 0xfc, 0x05},
+    // order 8
+    {0xc7, 0x17, 0x6a, 0x70, 0x3d, 0x4d, 0xd8, 0x4f, 0xba, 0x3c, 0x0b,
+     0x76, 0x0d, 0x10, 0x67, 0x0f, 0x2a, 0x20, 0x53, 0xfa, 0x2c, 0x39,
+     0xcc, 0xc6, 0x4e, 0xc7, 0xfd, 0x77, 0x92, 0xac, 0x03, 0x7a},
+    // p - 1 (order 2)
+    {0xec, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f},
+    // p (= 0, order 4)
+    {0xed, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f},
+    // p + 1 (= 1, order 1)
+    {0xee, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+     0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x7f}};
+
+/// Return true if the little endian scalar is less than the group order L.
+/// The comparison runs in constant time.
+constexpr auto is_canonical_scalar(std::span<const uint8_t, 32> s) noexcept
+    -> bool
+{
+    unsigned int c = 0;
+    unsigned int n = 1;
+    for (size_t i = 32; i-- > 0;)
+    {
+        const auto x = static_cast<unsigned int>(s[i]);
+        const auto l = static_cast<unsigned int>(group_order_bytes[i]);
+        c |= ((x - l) >> 8) & n;
+        n &= ((x ^ l) - 1) >> 8;
+    }
+    return c != 0;
+}  // is_canonical_scalar
+
+/// Return true if the encoded y-coordinate is less than p = 2^255 - 19. The
+/// sign bit is ignored. The comparison runs in constant time.
+constexpr auto is_canonical_point(std::span<const uint8_t, 32> p) noexcept
+    -> bool
+{
+    unsigned int c = (p[31] & 0x7fU) ^ 0x7fU;
+    for (size_t i = 30; i > 0; i--) c |= p[i] ^ 0xffU;
+    c = (c - 1U) >> 8;
+    const unsigned int d = (0xedU - 1U - static_cast<unsigned int>(p[0])) >> 8;
+    return (c & d & 1) == 0;
+}  // is_canonical_point
+
+/// Return true if the encoded point is one of the points of small order. The
+/// comparison runs in constant time.
+constexpr auto has_small_order(std::span<const uint8_t, 32> p) noexcept -> bool
+{
+    constexpr auto count = sizeof small_order_points / sizeof(uint8_t[32]);
+    auto c = std::array<unsigned int, count>{};
+    for (size_t j = 0; j < 32; ++j)
+    {
+        const auto b = static_cast<unsigned int>(j == 31 ? p[j] & 0x7f : p[j]);
+        for (size_t i = 0; i < count; ++i) c[i] |= b ^ small_order_points[i][j];
+    }
+    unsigned int k = 0;
+    for (size_t i = 0; i < count; ++i) k |= c[i] - 1;
+    return ((k >> 8) & 1) != 0;
+}  // has_small_order
+
 }  // namespace ed25519
 
 #endif  // VIPER25519_UTILS_HPP_
\ No newline at end of file
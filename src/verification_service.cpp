@@ -0,0 +1,266 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Standard Library Headers
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+// Public Viper25519 Headers
+#include <viper25519/batch_verifier.hpp>
+#include <viper25519/verification_service.hpp>
+
+using namespace ed25519;
+
+namespace  // unnamed namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Request
+{
+    PublicKey key;
+    std::vector<uint8_t> msg;
+    std::array<uint8_t, ED25519_SIGNATURE_SIZE> sig;
+    VerificationService::Completion done;
+    Clock::time_point submitted;
+};
+
+}  // unnamed namespace
+
+struct VerificationService::Impl
+{
+    Options options;
+    std::unique_ptr<ThreadPool> owned_pool;
+    ThreadPool* pool;
+
+    std::mutex mutex;
+    std::condition_variable queue_cv;
+    std::condition_variable idle_cv;
+    std::deque<Request> queue;
+    size_t in_flight = 0;
+    bool stop = false;
+    std::thread dispatcher;
+
+    Impl(ThreadPool* p, Options opts)
+        : options{opts},
+          owned_pool{p ? nullptr : std::make_unique<ThreadPool>()},
+          pool{p ? p : owned_pool.get()}
+    {
+        this->options.maxBatch = std::max<size_t>(this->options.maxBatch, 1);
+        this->dispatcher = std::thread([this] { this->dispatch(); });
+    }
+
+    /// Collect batches from the queue and hand them to the pool.
+    auto dispatch() -> void
+    {
+        auto lock = std::unique_lock(this->mutex);
+        while (true)
+        {
+            this->queue_cv.wait(
+                lock, [this] { return this->stop || !this->queue.empty(); }
+            );
+            if (this->queue.empty()) return;  // stopping
+
+            // Wait for a full batch or the deadline of the oldest request.
+            const auto deadline =
+                this->queue.front().submitted + this->options.maxDelay;
+            this->queue_cv.wait_until(
+                lock, deadline,
+                [this]
+                {
+                    return this->stop ||
+                           this->queue.size() >= this->options.maxBatch;
+                }
+            );
+
+            const auto count =
+                std::min(this->queue.size(), this->options.maxBatch);
+            auto batch = std::make_shared<std::vector<Request>>(
+                std::make_move_iterator(this->queue.begin()),
+                std::make_move_iterator(this->queue.begin() + count)
+            );
+            this->queue.erase(this->queue.begin(), this->queue.begin() + count);
+            ++this->in_flight;
+
+            lock.unlock();
+            this->pool->submit([this, batch] { this->run(*batch); });
+            lock.lock();
+        }
+    }
+
+    /// Verify a batch and complete its requests.
+    auto run(std::vector<Request>& batch) -> void
+    {
+        auto results = std::vector<bool>();
+        auto error = std::exception_ptr();
+        try
+        {
+            auto verifier = BatchVerifier(*this->pool, this->options.mode);
+            for (const auto& request : batch)
+                verifier.add(request.key, request.msg, request.sig);
+            results = verifier.verify();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        // Completions must not throw, but one that does should neither skip
+        // the rest of the batch nor take the pool thread down with it.
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            try
+            {
+                batch[i].done(error, error ? false : results[i]);
+            }
+            catch (...)
+            {
+            }
+        }
+
+        const auto lock = std::lock_guard(this->mutex);
+        --this->in_flight;
+        this->idle_cv.notify_all();
+    }
+};
+
+VerificationService::Awaitable::Awaitable(
+    VerificationService& service,
+    const PublicKey& key,
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+)
+    : service_{&service}, key_{key}, msg_(msg.begin(), msg.end()), sig_{}
+{
+    std::copy(sig.begin(), sig.end(), this->sig_.begin());
+}  // VerificationService::Awaitable::Awaitable
+
+auto VerificationService::Awaitable::await_suspend(
+    std::coroutine_handle<> handle
+) -> void
+{
+    this->service_->enqueue(
+        this->key_, std::move(this->msg_), this->sig_,
+        [this, handle](std::exception_ptr error, bool result)
+        {
+            this->error_ = error;
+            this->result_ = result;
+            handle.resume();
+        }
+    );
+}  // VerificationService::Awaitable::await_suspend
+
+auto VerificationService::Awaitable::await_resume() -> bool
+{
+    if (this->error_) std::rethrow_exception(this->error_);
+    return this->result_;
+}  // VerificationService::Awaitable::await_resume
+
+VerificationService::VerificationService(Options options)
+    : impl_{std::make_unique<Impl>(nullptr, options)}
+{
+}  // VerificationService::VerificationService
+
+VerificationService::VerificationService(ThreadPool& pool, Options options)
+    : impl_{std::make_unique<Impl>(&pool, options)}
+{
+}  // VerificationService::VerificationService
+
+VerificationService::~VerificationService()
+{
+    {
+        const auto lock = std::lock_guard(this->impl_->mutex);
+        this->impl_->stop = true;
+    }
+    this->impl_->queue_cv.notify_all();
+    this->impl_->dispatcher.join();
+
+    auto lock = std::unique_lock(this->impl_->mutex);
+    this->impl_->idle_cv.wait(lock, [this] { return !this->impl_->in_flight; });
+}  // VerificationService::~VerificationService
+
+auto VerificationService::submit(
+    const PublicKey& key,
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+) -> Awaitable
+{
+    return Awaitable(*this, key, msg, sig);
+}  // VerificationService::submit
+
+auto VerificationService::submitFuture(
+    const PublicKey& key,
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig
+) -> std::future<bool>
+{
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future();
+    this->enqueue(
+        key, std::vector<uint8_t>(msg.begin(), msg.end()), sig,
+        [promise](std::exception_ptr error, bool result)
+        {
+            if (error)
+                promise->set_exception(error);
+            else
+                promise->set_value(result);
+        }
+    );
+    return future;
+}  // VerificationService::submitFuture
+
+auto VerificationService::submitCallback(
+    const PublicKey& key,
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    Completion done
+) -> void
+{
+    this->enqueue(
+        key, std::vector<uint8_t>(msg.begin(), msg.end()), sig, std::move(done)
+    );
+}  // VerificationService::submitCallback
+
+auto VerificationService::enqueue(
+    const PublicKey& key,
+    std::vector<uint8_t>&& msg,
+    std::span<const uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    Completion&& done
+) -> void
+{
+    auto request =
+        Request{key, std::move(msg), {}, std::move(done), Clock::now()};
+    std::copy(sig.begin(), sig.end(), request.sig.begin());
+
+    auto notify = false;
+    {
+        const auto lock = std::lock_guard(this->impl_->mutex);
+        if (this->impl_->stop)
+            throw std::logic_error("Verification service is shutting down.");
+        this->impl_->queue.push_back(std::move(request));
+        notify = this->impl_->queue.size() == 1 ||
+                 this->impl_->queue.size() >= this->impl_->options.maxBatch;
+    }
+    if (notify) this->impl_->queue_cv.notify_one();
+}  // VerificationService::enqueue
@@ -18,31 +18,684 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 // THE SOFTWARE.
 
+
 #include <viper25519/vrf25519.hpp>
 
 // Standard library headers
+#include <array>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 // Third-party headers
-#include "sodium.h"
+#include <botan/hash.h>
+#include <botan/secmem.h>
 
 // Project headers
 #include <viper25519/curve25519.hpp>
+#include "instrumentation.hpp"
+#include "random.hpp"
+#include "utils.hpp"
 
 using namespace ed25519;
+using curve25519::bignum25519;
+using curve25519::ExtendedPoint;
+
+namespace  // unnamed namespace
+{
+
+// Both suites are ECVRF-EDWARDS25519-SHA512-ELL2 and share the suite string.
+constexpr uint8_t SUITE = 0x04;
+constexpr size_t CHALLENGE_SIZE = 16;
+
+/// Domain separation tag of the RFC 9381 hash to curve.
+constexpr auto H2C_DST =
+    std::string_view("ECVRF_edwards25519_XMD:SHA-512_ELL2_NU_\x04");
+
+/// The Montgomery curve coefficient A = 486662.
+constexpr auto curve_a = bignum25519{486662, 0, 0, 0, 0};
+
+/// sqrt(-486664) with an even encoding, used by the map from Curve25519 to
+/// edwards25519 (c1 in RFC 9380 appendix G.2.2).
+constexpr auto sqrt_neg_a_minus_two = bignum25519{
+    0x604aaff457e06, 0x2296fa350598d, 0x7f13dfb16874f, 0x35de93d846e01,
+    0x00f26edf460a00};
+
+constexpr auto one = bignum25519{1, 0, 0, 0, 0};
+
+auto is_zero(bignum25519 const &a) -> bool
+{
+    static constexpr auto zero = std::array<uint8_t, 32>{};
+    return mem_verify<32>(bignum25519::contract(a), zero);
+}  // is_zero
+
+auto is_equal(bignum25519 const &a, bignum25519 const &b) -> bool
+{
+    return is_zero(a.subReduce(b));
+}  // is_equal
+
+/// The sgn0 function of RFC 9380: the parity of the canonical encoding.
+auto is_odd(bignum25519 const &a) -> bool
+{
+    return (bignum25519::contract(a)[0] & 1) != 0;
+}  // is_odd
+
+/// Return a square root of a, or std::nullopt if a is not a square.
+/// Runs in variable time; only used on values derived from public inputs.
+auto square_root(bignum25519 const &a) -> std::optional<bignum25519>
+{
+    // r = a^((p + 3) / 8) is a root of a or of -a.
+    const auto r = a.pow_two252m3() * a;
+    const auto r2 = r.square();
+    if (is_equal(r2, a)) return r;
+    if (is_equal(r2, a.neg())) return r * bignum25519::sqrtneg1();
+    return std::nullopt;
+}  // square_root
+
+/// Return x^3 + A x^2 + x, the right hand side of the Montgomery curve.
+auto montgomery_rhs(bignum25519 const &x) -> bignum25519
+{
+    const auto x2 = x.square();
+    return (x2 * x).addReduce(x2 * curve_a).addReduce(x);
+}  // montgomery_rhs
+
+/// Hash to curve of draft-irtf-cfrg-vrf-03 (section 5.4.1.2), bit for bit
+/// as in the Cardano and Algorand libsodium forks.
+auto hash_to_curve_draft03(
+    std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::span<const uint8_t> msg
+) -> ExtendedPoint
+{
+    static constexpr uint8_t front = 0x01;
+    auto r_string = std::array<uint8_t, 64>{};
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    sha512->update(&SUITE, 1);
+    sha512->update(&front, 1);
+    sha512->update(pk.data(), pk.size());
+    sha512->update(msg.data(), msg.size());
+    sha512->final(r_string.data());
+    const auto r = bignum25519::expand(std::span(r_string).first<32>());
+
+    // Elligator 2: x = -A / (1 + 2r^2), or -x - A when the curve equation
+    // has no solution for x.
+    auto x = (curve_a * (r.square() + r.square() + one).recip()).neg();
+    if (!square_root(montgomery_rhs(x))) x = x.neg().subReduce(curve_a);
+
+    // Map to edwards25519 with y = (x - 1) / (x + 1), take the root with an
+    // even x-coordinate and clear the cofactor.
+    auto y_string = bignum25519::contract(
+        x.subReduce(one) * x.addReduce(one).recip()
+    );
+    y_string[31] &= 0x7f;
+    const auto p = ExtendedPoint::tryUnpack(y_string);
+    if (!p) throw std::logic_error("Elligator 2 produced an invalid point.");
+    return p->negate().mulByCofactor();
+}  // hash_to_curve_draft03
+
+/// Map a field element to edwards25519 with Elligator 2 (RFC 9380 sections
+/// 6.7.1 and 6.8.2). The cofactor is not cleared.
+auto map_to_curve_elligator2(bignum25519 const &u) -> ExtendedPoint
+{
+    // Montgomery point (s, t) with Z = 2
+    const auto tv = u.square() + u.square() + one;
+    auto x1 = (curve_a * tv.recip()).neg();
+    if (is_zero(x1)) x1 = curve_a.neg();
+    const auto x2 = x1.neg().subReduce(curve_a);
+
+    auto s = x1;
+    auto t = bignum25519{};
+    if (const auto y1 = square_root(montgomery_rhs(x1)))
+    {
+        t = is_odd(*y1) ? *y1 : y1->neg();
+    }
+    else
+    {
+        const auto y2 = square_root(montgomery_rhs(x2));
+        if (!y2) throw std::logic_error("Elligator 2 found no square root.");
+        s = x2;
+        t = is_odd(*y2) ? y2->neg() : *y2;
+    }
+
+    // Rational map to edwards25519: (x, y) = (c1 s / t, (s - 1) / (s + 1)),
+    // with the exceptional cases sent to the identity.
+    const auto s_plus_one = s.addReduce(one);
+    const auto den = t * s_plus_one;
+    if (is_zero(den)) return ExtendedPoint({bignum25519{}, one, one, {}});
+    const auto inv = den.recip();
+    const auto x = sqrt_neg_a_minus_two * s * s_plus_one * inv;
+    const auto y = s.subReduce(one) * t * inv;
+    return ExtendedPoint({x, y, one, x * y});
+}  // map_to_curve_elligator2
+
+/// encode_to_curve of RFC 9380 with the edwards25519_XMD:SHA-512_ELL2_NU_
+/// suite, salted with the public key as in RFC 9381 section 5.4.1.2.
+auto hash_to_curve_rfc9381(
+    std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::span<const uint8_t> msg
+) -> ExtendedPoint
+{
+    // expand_message_xmd(pk || msg, DST, 48)
+    static constexpr auto z_pad = std::array<uint8_t, 128>{};
+    static constexpr auto len = std::array<uint8_t, 2>{0, 48};
+    static constexpr uint8_t zero = 0x00;
+    static constexpr uint8_t index = 0x01;
+    static constexpr auto dst_len = static_cast<uint8_t>(H2C_DST.size());
+    const auto dst = std::span(
+        reinterpret_cast<const uint8_t *>(H2C_DST.data()), H2C_DST.size()
+    );
+
+    auto b0 = std::array<uint8_t, 64>{};
+    auto b1 = std::array<uint8_t, 64>{};
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    sha512->update(z_pad.data(), z_pad.size());
+    sha512->update(pk.data(), pk.size());
+    sha512->update(msg.data(), msg.size());
+    sha512->update(len.data(), len.size());
+    sha512->update(&zero, 1);
+    sha512->update(dst.data(), dst.size());
+    sha512->update(&dst_len, 1);
+    sha512->final(b0.data());
+    sha512->update(b0.data(), b0.size());
+    sha512->update(&index, 1);
+    sha512->update(dst.data(), dst.size());
+    sha512->update(&dst_len, 1);
+    sha512->final(b1.data());
+
+    // u = OS2IP(b1[0..48]) mod p. Split the big endian integer into the low
+    // 255 bits, bit 255 and the high 128 bits, using 2^255 = 19 and
+    // 2^256 = 38 (mod p).
+    auto lo = std::array<uint8_t, 32>{};
+    auto hi = std::array<uint8_t, 32>{};
+    for (size_t i = 0; i < 32; ++i) lo[i] = b1[47 - i];
+    for (size_t i = 0; i < 16; ++i) hi[i] = b1[15 - i];
+    const auto top = bignum25519{static_cast<uint64_t>(lo[31] >> 7) * 19};
+    const auto u = bignum25519::expand(lo)
+                       .addReduce(top)
+                       .addReduce(bignum25519::expand(hi) * bignum25519{38});
+
+    return map_to_curve_elligator2(u).mulByCofactor();
+}  // hash_to_curve_rfc9381
+
+auto hash_to_curve(
+    VRFSuite suite, std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::span<const uint8_t> msg
+) -> ExtendedPoint
+{
+    if (suite == VRFSuite::Rfc9381) return hash_to_curve_rfc9381(pk, msg);
+    return hash_to_curve_draft03(pk, msg);
+}  // hash_to_curve
+
+/// Challenge c = Hash(suite || 0x02 || [Y] || H || Gamma || U || V || [0x00])
+/// truncated to 16 bytes. The bracketed parts are only in RFC 9381.
+auto challenge(
+    VRFSuite suite, std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::span<const std::array<uint8_t, 32>, 4> points
+) -> std::array<uint8_t, 32>
+{
+    static constexpr uint8_t front = 0x02;
+    static constexpr uint8_t back = 0x00;
+    auto digest = std::array<uint8_t, 64>{};
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    sha512->update(&SUITE, 1);
+    sha512->update(&front, 1);
+    if (suite == VRFSuite::Rfc9381) sha512->update(pk.data(), pk.size());
+    for (const auto &p : points) sha512->update(p.data(), p.size());
+    if (suite == VRFSuite::Rfc9381) sha512->update(&back, 1);
+    sha512->final(digest.data());
+
+    // Zero padded to the width of a scalar
+    auto c = std::array<uint8_t, 32>{};
+    std::copy_n(digest.begin(), CHALLENGE_SIZE, c.begin());
+    return c;
+}  // challenge
+
+/// The parts of a decoded proof.
+struct DecodedProof
+{
+    ExtendedPoint gamma_neg;  // -Gamma, as returned by tryUnpack
+    std::array<uint8_t, 32> c;
+    std::array<uint8_t, 32> s;
+};
+
+/// Decode a proof, returning std::nullopt if Gamma is not a point. RFC 9381
+/// additionally requires a canonical Gamma and s < L, while draft-03 reduces
+/// s modulo L as libsodium does.
+auto decode_proof(
+    std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof, VRFSuite suite
+) -> std::optional<DecodedProof>
+{
+    const auto gamma = proof.first<32>();
+    const auto s = proof.last<32>();
+    if (suite == VRFSuite::Rfc9381 &&
+        (!is_canonical_point(gamma) || !is_canonical_scalar(s)))
+        return std::nullopt;
+    const auto gamma_neg = ExtendedPoint::tryUnpack(gamma);
+    if (!gamma_neg) return std::nullopt;
+
+    auto decoded = DecodedProof{*gamma_neg, {}, {}};
+    std::copy_n(proof.begin() + 32, CHALLENGE_SIZE, decoded.c.begin());
+    std::copy(s.begin(), s.end(), decoded.s.begin());
+    return decoded;
+}  // decode_proof
+
+/// Expand a VRF seed into the clamped secret scalar (first half) and the
+/// nonce key (second half) as in RFC 8032 section 5.1.5.
+auto expand_seed(std::span<const uint8_t, ED25519_VRF_SEED_SIZE> seed)
+    -> ExtKeyByteArray
+{
+    auto az = ExtKeyByteArray{};
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    sha512->update(seed.data(), seed.size());
+    sha512->final(az.data());
+    az[0] &= 248;
+    az[31] &= 127;
+    az[31] |= 64;
+    return az;
+}  // expand_seed
+
+auto public_key_from_seed(std::span<const uint8_t, ED25519_VRF_SEED_SIZE> seed)
+    -> std::array<uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE>
+{
+    const auto az = expand_seed(seed);
+    const auto x = bignum25519::expand256_modm(std::span(az).first<32>());
+    return ExtendedPoint::multiplyBasepointByScalar(x).pack();
+}  // public_key_from_seed
+
+/// Encodings of the points H, Gamma, U = [k]B and V = [k]H of a proof
+/// together with its challenge and response, and [8]Gamma if requested.
+struct ProofParts
+{
+    std::array<std::array<uint8_t, 32>, 4> points;
+    std::array<uint8_t, 32> c;
+    std::array<uint8_t, 32> s;
+    std::array<uint8_t, 32> gamma8;
+};
+
+/// Prove several messages with the expanded secret key az (as from
+/// expand_seed) and the matching public key. The points H of all proofs are
+/// encoded with one field inversion, and so are the points of all proofs
+/// together with [8]Gamma if with_output is set.
+auto prove_batch(
+    std::span<const uint8_t, ED25519_EXTENDED_KEY_SIZE> az,
+    std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::span<const std::span<const uint8_t>> msgs, VRFSuite suite,
+    bool with_output
+) -> std::vector<ProofParts>
+{
+    const auto n = msgs.size();
+    const auto stride = with_output ? size_t{5} : size_t{4};
+
+    // The secret scalar x and the nonces k_i are kept in memory that is
+    // wiped when it is released.
+    auto secrets = Botan::SecureVector<bignum25519>(n + 1);
+    auto& x = secrets[n];
+    x = bignum25519::expand256_modm(az.first<32>());
+    const auto ks = std::span(secrets).first(n);
+
+    auto hs = std::vector<ExtendedPoint>();
+    hs.reserve(n);
+    for (const auto msg : msgs) hs.push_back(hash_to_curve(suite, pk, msg));
+    const auto h_strings = ExtendedPoint::packBatch(hs);
+
+    // Nonce k = Hash(az[32..64] || H) mod L (RFC 8032 style), then
+    // Gamma = [x]H and the commitments [k]B and [k]H
+    auto points = std::vector<ExtendedPoint>();
+    points.reserve(stride * n);
+    auto k_string = ExtKeyByteArray{};
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    for (size_t i = 0; i < n; ++i)
+    {
+        sha512->update(az.data() + 32, 32);
+        sha512->update(h_strings[i].data(), h_strings[i].size());
+        sha512->final(k_string.data());
+        ks[i] = bignum25519::expand256_modm(k_string);
+
+        const auto gamma = hs[i].scalarMultiple(x);
+        points.push_back(hs[i]);
+        points.push_back(gamma);
+        points.push_back(ExtendedPoint::multiplyBasepointByScalar(ks[i]));
+        points.push_back(hs[i].scalarMultiple(ks[i]));
+        if (with_output) points.push_back(gamma.mulByCofactor());
+    }
+    const auto packed = ExtendedPoint::packBatch(points);
+
+    auto parts = std::vector<ProofParts>(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto offset = packed.begin() + static_cast<ptrdiff_t>(stride * i);
+        std::copy_n(offset, parts[i].points.size(), parts[i].points.begin());
+        if (with_output) parts[i].gamma8 = offset[4];
+        parts[i].c = challenge(suite, pk, parts[i].points);
+
+        // s = c x + k (mod L)
+        const auto c = bignum25519::expand256_modm(parts[i].c);
+        parts[i].s = bignum25519::contract256_modm(
+            bignum25519::add256_modm(bignum25519::mul256_modm(c, x), ks[i])
+        );
+    }
+    return parts;
+}  // prove_batch
+
+auto prove(
+    std::span<const uint8_t, ED25519_EXTENDED_KEY_SIZE> az,
+    std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::span<const uint8_t> msg, VRFSuite suite, bool with_output
+) -> ProofParts
+{
+    return prove_batch(az, pk, std::span(&msg, 1), suite, with_output)[0];
+}  // prove
+
+/// Gamma || c || s
+auto encode_proof(ProofParts const &parts)
+    -> std::array<uint8_t, ED25519_VRF_PROOF_SIZE>
+{
+    auto proof = std::array<uint8_t, ED25519_VRF_PROOF_SIZE>{};
+    std::copy(parts.points[1].begin(), parts.points[1].end(), proof.begin());
+    std::copy_n(parts.c.begin(), CHALLENGE_SIZE, proof.begin() + 32);
+    std::copy(parts.s.begin(), parts.s.end(), proof.begin() + 48);
+    return proof;
+}  // encode_proof
+
+/// Gamma || U || V || s
+auto encode_batch_proof(ProofParts const &parts)
+    -> std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>
+{
+    auto proof = std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>{};
+    for (size_t i = 1; i < parts.points.size(); ++i)
+        std::copy(
+            parts.points[i].begin(), parts.points[i].end(),
+            proof.begin() + 32 * static_cast<ptrdiff_t>(i - 1)
+        );
+    std::copy(parts.s.begin(), parts.s.end(), proof.begin() + 96);
+    return proof;
+}  // encode_batch_proof
+
+/// beta = Hash(suite || 0x03 || [8]Gamma || [0x00]) from the encoding of
+/// [8]Gamma.
+auto output_hash(std::span<const uint8_t, 32> gamma8, VRFSuite suite)
+    -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>
+{
+    static constexpr uint8_t front = 0x03;
+    static constexpr uint8_t back = 0x00;
+    auto hash = std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>{};
+    const auto sha512 = Botan::HashFunction::create("SHA-512");
+    sha512->update(&SUITE, 1);
+    sha512->update(&front, 1);
+    sha512->update(gamma8.data(), gamma8.size());
+    if (suite == VRFSuite::Rfc9381) sha512->update(&back, 1);
+    sha512->final(hash.data());
+    return hash;
+}  // output_hash
+
+auto gamma_to_hash(ExtendedPoint const &gamma_neg, VRFSuite suite)
+    -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>
+{
+    const auto gamma8 = gamma_neg.negate().mulByCofactor().pack();
+    return output_hash(gamma8, suite);
+}  // gamma_to_hash
+
+/// Compute the VRF hashes of several messages without proving them. Only
+/// Gamma = [x]H is needed, and [8]Gamma of all messages is encoded with one
+/// field inversion.
+auto hash_batch(
+    std::span<const uint8_t, ED25519_EXTENDED_KEY_SIZE> az,
+    std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::span<const std::span<const uint8_t>> msgs, VRFSuite suite
+) -> std::vector<std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>
+{
+    auto secret = Botan::SecureVector<bignum25519>(1);
+    auto& x = secret[0];
+    x = bignum25519::expand256_modm(az.first<32>());
+
+    auto gamma8s = std::vector<ExtendedPoint>();
+    gamma8s.reserve(msgs.size());
+    for (const auto msg : msgs)
+        gamma8s.push_back(
+            hash_to_curve(suite, pk, msg).scalarMultiple(x).mulByCofactor()
+        );
+    const auto packed = ExtendedPoint::packBatch(gamma8s);
+
+    auto hashes =
+        std::vector<std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>();
+    hashes.reserve(packed.size());
+    for (const auto& gamma8 : packed)
+        hashes.push_back(output_hash(gamma8, suite));
+    return hashes;
+}  // hash_batch
+
+/// The parts of a decoded batch compatible proof. The points are negated as
+/// returned by tryUnpack.
+struct DecodedBatchProof
+{
+    ExtendedPoint gamma_neg;
+    ExtendedPoint u_neg;
+    ExtendedPoint v_neg;
+    bignum25519 s;
+};
+
+/// Decode Gamma || U || V || s, requiring canonical encodings and s < L.
+auto decode_batch_proof(
+    std::span<const uint8_t, ED25519_VRF_BATCH_PROOF_SIZE> proof
+) -> std::optional<DecodedBatchProof>
+{
+    auto points = std::array<ExtendedPoint, 3>{};
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        const auto bytes =
+            std::span<const uint8_t, 32>(proof.subspan(32 * i, 32));
+        if (!is_canonical_point(bytes)) return std::nullopt;
+        const auto p = ExtendedPoint::tryUnpack(bytes);
+        if (!p) return std::nullopt;
+        points[i] = *p;
+    }
+    const auto s = proof.last<32>();
+    if (!is_canonical_scalar(s)) return std::nullopt;
+    return DecodedBatchProof{
+        points[0], points[1], points[2], bignum25519::expand256_modm(s)};
+}  // decode_batch_proof
+
+/// Recompute the challenge of a batch compatible proof from the encodings
+/// of H, Gamma, U and V.
+auto batch_challenge(
+    std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    std::array<uint8_t, 32> const &h_string,
+    std::span<const uint8_t, ED25519_VRF_BATCH_PROOF_SIZE> proof
+) -> bignum25519
+{
+    auto points = std::array<std::array<uint8_t, 32>, 4>{h_string};
+    for (size_t i = 1; i < points.size(); ++i)
+        std::copy_n(proof.begin() + 32 * (i - 1), 32, points[i].begin());
+    return bignum25519::expand256_modm(
+        challenge(VRFSuite::Rfc9381, pk, points)
+    );
+}  // batch_challenge
+
+/// Decode and check a VRF public key, returning -Y.
+auto decode_public_key(std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk)
+    -> std::optional<ExtendedPoint>
+{
+    if (!is_canonical_point(pk) || has_small_order(pk)) return std::nullopt;
+    return ExtendedPoint::tryUnpack(pk);
+}  // decode_public_key
+
+/// Verify an 80 byte proof. On success return the encoding of [8]Gamma if
+/// with_output is set, and zeros otherwise, so that the output can share the
+/// field inversion used to encode the challenge points.
+auto verify_proof(
+    std::span<const uint8_t, ED25519_VRF_PUBLIC_KEY_SIZE> pk,
+    ExtendedPoint const &y_neg, std::span<const uint8_t> msg,
+    std::span<const uint8_t> proof, VRFSuite suite, bool with_output
+) -> std::optional<std::array<uint8_t, 32>>
+{
+    if (proof.size() != ED25519_VRF_PROOF_SIZE) return std::nullopt;
+
+    const auto decoded =
+        decode_proof(proof.first<ED25519_VRF_PROOF_SIZE>(), suite);
+    if (!decoded) return std::nullopt;
+    const auto c = bignum25519::expand256_modm(decoded->c);
+    const auto s = bignum25519::expand256_modm(decoded->s);
+
+    // U = [s]B - [c]Y and V = [s]H - [c]Gamma
+    const auto h = hash_to_curve(suite, pk, msg);
+    const auto u = y_neg.doubleScalarMultiple(c, s);
+    const auto v = ExtendedPoint::multiScalarMultiple(
+        std::array{s, c}, std::array{h, decoded->gamma_neg}
+    );
+
+    // Gamma is re-encoded as the reference implementations do.
+    const auto gamma = decoded->gamma_neg.negate();
+    auto points = std::array{h, gamma, u, v, ExtendedPoint{}};
+    if (with_output) points[4] = gamma.mulByCofactor();
+    const auto packed = ExtendedPoint::packBatch(
+        std::span(points).first(with_output ? 5 : 4)
+    );
+    const auto expected =
+        challenge(suite, pk, std::span(packed).first<4>());
+    if (!mem_verify<CHALLENGE_SIZE>(
+            std::span(expected).first<CHALLENGE_SIZE>(),
+            std::span(decoded->c).first<CHALLENGE_SIZE>()
+        ))
+        return std::nullopt;
+    return with_output ? packed[4] : std::array<uint8_t, 32>{};
+}  // verify_proof
+
+}  // unnamed namespace
 
 auto VRFPublicKey::verifyProof(
-    std::span<const uint8_t> msg, std::span<const uint8_t> proof
+    std::span<const uint8_t> msg, std::span<const uint8_t> proof,
+    VRFSuite suite
 ) const -> bool
 {
-    unsigned char output[64];
-    auto pk_bytes = this->bytes();
-    auto result = crypto_vrf_ietfdraft03_verify(
-        output, pk_bytes.data(), proof.data(), msg.data(), msg.size()
-    );
-    return result == 0;
+    VIPER25519_INSTRUMENT(VrfVerify);
+    const auto pk = std::span(this->bytes());
+    const auto y_neg = decode_public_key(pk);
+    if (!y_neg) return false;
+    return verify_proof(pk, *y_neg, msg, proof, suite, false).has_value();
 }  // VRFPublicKey::verifyProof
 
+auto VRFPublicKey::verifyProofAndHash(
+    std::span<const uint8_t> msg, std::span<const uint8_t> proof,
+    VRFSuite suite
+) const -> std::optional<std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>
+{
+    VIPER25519_INSTRUMENT(VrfVerify);
+    const auto pk = std::span(this->bytes());
+    const auto y_neg = decode_public_key(pk);
+    if (!y_neg) return std::nullopt;
+    const auto gamma8 = verify_proof(pk, *y_neg, msg, proof, suite, true);
+    if (!gamma8) return std::nullopt;
+    return output_hash(*gamma8, suite);
+}  // VRFPublicKey::verifyProofAndHash
+
+
+auto VRFPublicKey::verifyBatchCompatibleProof(
+    std::span<const uint8_t> msg,
+    std::span<const uint8_t, ED25519_VRF_BATCH_PROOF_SIZE> proof
+) const -> bool
+{
+    VIPER25519_INSTRUMENT(VrfVerify);
+    const auto pk = std::span(this->bytes());
+    const auto y_neg = decode_public_key(pk);
+    const auto decoded = decode_batch_proof(proof);
+    if (!y_neg || !decoded) return false;
+
+    const auto h = hash_to_curve_rfc9381(pk, msg);
+    const auto c = batch_challenge(pk, h.pack(), proof);
+
+    // The proof carries U and V, so check that [8]([s]B - [c]Y - U) and
+    // [8]([s]H - [c]Gamma - V) are the identity. The check is cofactored
+    // like verifyProofBatch so that both accept exactly the same proofs.
+    // The multiplications by the cofactor also restore the T coordinate
+    // that doubleScalarMultiple does not maintain.
+    const auto u = y_neg->doubleScalarMultiple(c, decoded->s);
+    const auto v = ExtendedPoint::multiScalarMultiple(
+        std::array{decoded->s, c}, std::array{h, decoded->gamma_neg}
+    );
+    const auto du = u.mulByCofactor() + decoded->u_neg.mulByCofactor();
+    const auto dv = v.mulByCofactor() + decoded->v_neg.mulByCofactor();
+    return du.isIdentity() && dv.isIdentity();
+}  // VRFPublicKey::verifyBatchCompatibleProof
+
+auto VRFPublicKey::verifyProofBatch(
+    std::span<const VRFPublicKey> keys,
+    std::span<const std::span<const uint8_t>> msgs,
+    std::span<const std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>> proofs
+) -> bool
+{
+    if (keys.size() != msgs.size() || keys.size() != proofs.size())
+        throw std::invalid_argument("Key, message and proof counts differ.");
+    const auto n = proofs.size();
+    if (n == 0) return true;
+
+    // Decode everything and hash every message to the curve, encoding all of
+    // the points H_i with a single inversion.
+    auto decoded = std::vector<DecodedBatchProof>();
+    auto y_negs = std::vector<ExtendedPoint>();
+    auto hs = std::vector<ExtendedPoint>();
+    decoded.reserve(n);
+    y_negs.reserve(n);
+    hs.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto pk = std::span(keys[i].bytes());
+        const auto y_neg = decode_public_key(pk);
+        const auto proof = decode_batch_proof(proofs[i]);
+        if (!y_neg || !proof) return false;
+        y_negs.push_back(*y_neg);
+        decoded.push_back(*proof);
+        hs.push_back(hash_to_curve_rfc9381(pk, msgs[i]));
+    }
+    const auto h_strings = ExtendedPoint::packBatch(hs);
+
+    // With random 128 bit z_i and w_i check that
+    //   [8](sum [z_i]([s_i]B - [c_i]Y_i - U_i)
+    //       + [w_i]([s_i]H_i - [c_i]Gamma_i - V_i))
+    // is the identity. Unpacking already provides the negated points.
+    auto random = std::vector<uint8_t>(32 * n);
+    ChaCha20Rng::local().randomize(random);
+
+    auto scalars = std::vector<bignum25519>();
+    auto points = std::vector<ExtendedPoint>();
+    scalars.reserve(5 * n);
+    points.reserve(5 * n);
+    auto sum = bignum25519{};
+    for (size_t i = 0; i < n; ++i)
+    {
+        auto z_raw = std::array<uint8_t, 32>{};
+        auto w_raw = std::array<uint8_t, 32>{};
+        const auto offset = random.begin() + 32 * static_cast<ptrdiff_t>(i);
+        std::copy_n(offset, 16, z_raw.begin());
+        std::copy_n(offset + 16, 16, w_raw.begin());
+        const auto z = bignum25519::expand256_modm(z_raw);
+        const auto w = bignum25519::expand256_modm(w_raw);
+
+        const auto& proof = decoded[i];
+        const auto c = batch_challenge(
+            std::span(keys[i].bytes()), h_strings[i], proofs[i]
+        );
+        sum = bignum25519::add256_modm(
+            sum, bignum25519::mul256_modm(z, proof.s)
+        );
+
+        scalars.push_back(bignum25519::mul256_modm(z, c));
+        points.push_back(y_negs[i]);
+        scalars.push_back(z);
+        points.push_back(proof.u_neg);
+        scalars.push_back(bignum25519::mul256_modm(w, proof.s));
+        points.push_back(hs[i]);
+        scalars.push_back(bignum25519::mul256_modm(w, c));
+        points.push_back(proof.gamma_neg);
+        scalars.push_back(w);
+        points.push_back(proof.v_neg);
+    }
+
+    const auto lhs = ExtendedPoint::multiplyBasepointByScalar(sum);
+    const auto rhs = ExtendedPoint::multiScalarMultiple(scalars, points);
+    return (lhs.mulByCofactor() + rhs.mulByCofactor()).isIdentity();
+}  // VRFPublicKey::verifyProofBatch
+
 VRFSecretKey::VRFSecretKey(
     std::span<const uint8_t, ED25519_VRF_SECRET_KEY_SIZE> prv
 )
@@ -60,8 +713,7 @@ auto VRFSecretKey::generate() -> VRFSecretKey
 auto VRFSecretKey::fromSeed(std::span<const uint8_t, ED25519_VRF_SEED_SIZE> seed
 ) -> VRFSecretKey
 {
-    const auto seed_key = ed25519::PrivateKey(seed);
-    const auto pkey_bytes = seed_key.extend().publicKey().bytes();
+    const auto pkey_bytes = public_key_from_seed(seed);
     auto skey_bytes = ed25519::ExtKeyByteArray{};
     std::copy_n(seed.begin(), ED25519_VRF_SEED_SIZE, skey_bytes.begin());
     std::copy_n(
@@ -83,66 +735,186 @@ auto VRFSecretKey::publicKey() const -> VRFPublicKey
 
 auto VRFSecretKey::isValid() const -> bool
 {
-    auto sk =
-        ed25519::PrivateKey(std::span(this->prv_).first<ED25519_KEY_SIZE>());
-    if (!sk.isValid())
-    {
-        return false;
-    }
-
-    auto pk = ed25519::PublicKey(
-        std::span(this->prv_).subspan<ED25519_KEY_SIZE, ED25519_KEY_SIZE>()
+    const auto pk = public_key_from_seed(
+        std::span(this->prv_).first<ED25519_VRF_SEED_SIZE>()
+    );
+    return mem_verify<ED25519_VRF_PUBLIC_KEY_SIZE>(
+        pk, std::span(this->prv_).last<ED25519_VRF_PUBLIC_KEY_SIZE>()
     );
-    return pk.bytes() == sk.publicKey().bytes();
 }  // VRFSecretKey::isValid
 
 auto VRFSecretKey::sign(std::span<const uint8_t> msg) const
     -> std::array<uint8_t, ED25519_SIGNATURE_SIZE>
 {
-    auto sk =
-        ed25519::PrivateKey(std::span(this->prv_).first<ED25519_KEY_SIZE>());
-    return sk.sign(msg);
+    // Sign with the same expanded key as the VRF so that the signature
+    // matches publicKey() whatever the third highest bit of the hashed seed.
+    const auto seed = std::span(this->prv_).first<ED25519_VRF_SEED_SIZE>();
+    const auto az = expand_seed(seed);
+    return ed25519::ExtendedPrivateKey(az).sign(msg);
 }  // VRFSecretKey::sign
 
-auto VRFSecretKey::constructProof(std::span<const uint8_t> msg)
-    -> std::array<uint8_t, ED25519_VRF_PROOF_SIZE>
+auto VRFSecretKey::constructProof(
+    std::span<const uint8_t> msg, VRFSuite suite
+) -> std::array<uint8_t, ED25519_VRF_PROOF_SIZE>
 {
-    auto proof = std::array<uint8_t, ED25519_VRF_PROOF_SIZE>{};
-    auto result = crypto_vrf_ietfdraft03_prove(
-        proof.data(), this->prv_.data(), msg.data(), msg.size()
-    );
-    if (result != 0)
-    {
-        throw std::runtime_error("crypto_vrf_prove failed.");
-    }
-    return proof;
+    VIPER25519_INSTRUMENT(VrfProve);
+    const auto skpk = std::span(this->prv_);
+    const auto az = expand_seed(skpk.first<ED25519_VRF_SEED_SIZE>());
+    return encode_proof(prove(
+        az, skpk.last<ED25519_VRF_PUBLIC_KEY_SIZE>(), msg, suite, false
+    ));
 }  // VRFSecretKey::constructProof
 
+auto VRFSecretKey::constructBatchCompatibleProof(
+    std::span<const uint8_t> msg
+) const -> std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>
+{
+    VIPER25519_INSTRUMENT(VrfProve);
+    const auto skpk = std::span(this->prv_);
+    const auto az = expand_seed(skpk.first<ED25519_VRF_SEED_SIZE>());
+    return encode_batch_proof(prove(
+        az, skpk.last<ED25519_VRF_PUBLIC_KEY_SIZE>(), msg, VRFSuite::Rfc9381,
+        false
+    ));
+}  // VRFSecretKey::constructBatchCompatibleProof
+
 auto VRFSecretKey::verifyProof(
     std::span<const uint8_t> msg,
-    std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof
+    std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof, VRFSuite suite
 ) const -> bool
 {
     auto pk = this->publicKey();
-    return pk.verifyProof(msg, proof);
+    return pk.verifyProof(msg, proof, suite);
 }  // VRFSecretKey::verifyProof
 
 auto VRFSecretKey::proofToHash(
-    std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof
+    std::span<const uint8_t, ED25519_VRF_PROOF_SIZE> proof, VRFSuite suite
 ) -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>
 {
-    auto hash = std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>{};
-    auto result =
-        crypto_vrf_ietfdraft03_proof_to_hash(hash.data(), proof.data());
-    if (result != 0)
+    // draft-03 only decodes Gamma, RFC 9381 decodes the whole proof.
+    auto gamma_neg = std::optional<ExtendedPoint>{};
+    if (suite == VRFSuite::Rfc9381)
     {
-        throw std::runtime_error("crypto_vrf_proof_to_hash failed.");
+        if (const auto decoded = decode_proof(proof, suite))
+            gamma_neg = decoded->gamma_neg;
     }
-    return hash;
+    else
+    {
+        gamma_neg = ExtendedPoint::tryUnpack(proof.first<32>());
+    }
+    if (!gamma_neg) throw std::runtime_error("Invalid VRF proof.");
+
+    return gamma_to_hash(*gamma_neg, suite);
 }  // VRFSecretKey::proofToHash
 
-auto VRFSecretKey::hash(std::span<const uint8_t> msg)
+auto VRFSecretKey::batchCompatibleProofToHash(
+    std::span<const uint8_t, ED25519_VRF_BATCH_PROOF_SIZE> proof
+) -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>
+{
+    const auto decoded = decode_batch_proof(proof);
+    if (!decoded) throw std::runtime_error("Invalid VRF proof.");
+    return gamma_to_hash(decoded->gamma_neg, VRFSuite::Rfc9381);
+}  // VRFSecretKey::batchCompatibleProofToHash
+
+auto VRFSecretKey::hash(std::span<const uint8_t> msg, VRFSuite suite)
     -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>
 {
-    return VRFSecretKey::proofToHash(this->constructProof(msg));
+    return VRFSecretKey::proofToHash(this->constructProof(msg, suite), suite);
 }  // VRFSecretKey::hash
+
+PreparedVRFSecretKey::PreparedVRFSecretKey(VRFSecretKey const &key)
+    : pk_{std::span(key.bytes()).last<ED25519_VRF_PUBLIC_KEY_SIZE>()}
+{
+    const auto skpk = std::span(key.bytes());
+    this->az_ = expand_seed(skpk.first<ED25519_VRF_SEED_SIZE>());
+
+    // The check of VRFSecretKey::isValid, done once here.
+    const auto az = std::span(this->az_);
+    const auto x = bignum25519::expand256_modm(az.first<32>());
+    const auto y = ExtendedPoint::multiplyBasepointByScalar(x);
+    if (!mem_verify<ED25519_VRF_PUBLIC_KEY_SIZE>(y.pack(), this->pk_.bytes()))
+        throw std::invalid_argument("Invalid VRF secret key.");
+    this->y_neg_ = y.negate();
+}  // PreparedVRFSecretKey::PreparedVRFSecretKey
+
+auto PreparedVRFSecretKey::constructProof(
+    std::span<const uint8_t> msg, VRFSuite suite
+) const -> std::array<uint8_t, ED25519_VRF_PROOF_SIZE>
+{
+    VIPER25519_INSTRUMENT(VrfProve);
+    return encode_proof(
+        prove(this->az_, this->pk_.bytes(), msg, suite, false)
+    );
+}  // PreparedVRFSecretKey::constructProof
+
+auto PreparedVRFSecretKey::constructProofAndHash(
+    std::span<const uint8_t> msg, VRFSuite suite
+) const
+    -> std::pair<
+        std::array<uint8_t, ED25519_VRF_PROOF_SIZE>,
+        std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>
+{
+    VIPER25519_INSTRUMENT(VrfProve);
+    const auto parts = prove(this->az_, this->pk_.bytes(), msg, suite, true);
+    return {encode_proof(parts), output_hash(parts.gamma8, suite)};
+}  // PreparedVRFSecretKey::constructProofAndHash
+
+auto PreparedVRFSecretKey::constructBatchCompatibleProof(
+    std::span<const uint8_t> msg
+) const -> std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>
+{
+    VIPER25519_INSTRUMENT(VrfProve);
+    return encode_batch_proof(
+        prove(this->az_, this->pk_.bytes(), msg, VRFSuite::Rfc9381, false)
+    );
+}  // PreparedVRFSecretKey::constructBatchCompatibleProof
+
+auto PreparedVRFSecretKey::hash(
+    std::span<const uint8_t> msg, VRFSuite suite
+) const -> std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>
+{
+    VIPER25519_INSTRUMENT(VrfProve);
+    return hash_batch(this->az_, this->pk_.bytes(), std::span(&msg, 1), suite)
+        .front();
+}  // PreparedVRFSecretKey::hash
+
+auto PreparedVRFSecretKey::hashBatch(
+    std::span<const std::span<const uint8_t>> msgs, VRFSuite suite
+) const -> std::vector<std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>
+{
+    VIPER25519_INSTRUMENT(VrfProve);
+    return hash_batch(this->az_, this->pk_.bytes(), msgs, suite);
+}  // PreparedVRFSecretKey::hashBatch
+
+auto PreparedVRFSecretKey::verifyProof(
+    std::span<const uint8_t> msg, std::span<const uint8_t> proof,
+    VRFSuite suite
+) const -> bool
+{
+    VIPER25519_INSTRUMENT(VrfVerify);
+    const auto gamma8 = verify_proof(
+        this->pk_.bytes(), this->y_neg_, msg, proof, suite, false
+    );
+    return gamma8.has_value();
+}  // PreparedVRFSecretKey::verifyProof
+
+auto PreparedVRFSecretKey::constructProofAndHashBatch(
+    std::span<const std::span<const uint8_t>> msgs, VRFSuite suite
+) const
+    -> std::vector<std::pair<
+        std::array<uint8_t, ED25519_VRF_PROOF_SIZE>,
+        std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>>
+{
+    VIPER25519_INSTRUMENT(VrfProve);
+    const auto parts =
+        prove_batch(this->az_, this->pk_.bytes(), msgs, suite, true);
+    auto results = std::vector<std::pair<
+        std::array<uint8_t, ED25519_VRF_PROOF_SIZE>,
+        std::array<uint8_t, ED25519_VRF_PROOF_HASH_SIZE>>>();
+    results.reserve(parts.size());
+    for (const auto& part : parts)
+        results.emplace_back(
+            encode_proof(part), output_hash(part.gamma8, suite)
+        );
+    return results;
+}  // PreparedVRFSecretKey::constructProofAndHashBatch
@@ -1,5 +1,19 @@
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+#include <viper25519/batch_verifier.hpp>
 #include <viper25519/curve25519.hpp>
 #include <viper25519/ed25519.hpp>
+#include <viper25519/latency.hpp>
+#include <viper25519/perf_counters.hpp>
+#include <viper25519/point_cache.hpp>
+#include <viper25519/signature_cache.hpp>
+#include <viper25519/thread_pool.hpp>
+#include <viper25519/verification_service.hpp>
 
 #include "testing.hpp"
 
@@ -183,6 +197,147 @@ auto testKeyAdd() -> void
     TEST_ASSERT_THROW(skey_added_lower_bytes == res_skey)
 }
 
+auto testNonThrowingApi() -> void
+{
+    constexpr auto pub_key_bytes = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe,
+        0xd3, 0xc9, 0x64, 0x07, 0x3a, 0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6,
+        0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a
+    };
+    auto sig = std::array<uint8_t, ED25519_SIGNATURE_SIZE>{
+        0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2,
+        0xcc, 0x80, 0x6e, 0x82, 0x8a, 0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5,
+        0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55, 0x5f,
+        0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70,
+        0x1c, 0xf9, 0xb4, 0x6b, 0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe,
+        0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b
+    };
+    const auto msg = std::vector<uint8_t>{};
+    const auto pub_key = PublicKey(pub_key_bytes);
+    TEST_ASSERT_THROW(
+        pub_key.tryVerifySignature(msg, sig) == VerifyResult::Valid
+    )
+
+    sig[0] ^= 0x01;
+    TEST_ASSERT_THROW(
+        pub_key.tryVerifySignature(msg, sig) == VerifyResult::Invalid
+    )
+    sig[0] ^= 0x01;
+
+    sig[63] |= 0x80;
+    TEST_ASSERT_THROW(
+        pub_key.tryVerifySignature(msg, sig) ==
+        VerifyResult::MalformedSignature
+    )
+    sig[63] &= 0x7f;
+
+    // y = 2 is not the y-coordinate of any point on the curve.
+    auto bad_key_bytes = std::array<uint8_t, ED25519_KEY_SIZE>{0x02};
+    const auto bad_key = PublicKey(bad_key_bytes);
+    TEST_ASSERT_THROW(
+        bad_key.tryVerifySignature(msg, sig) ==
+        VerifyResult::MalformedPublicKey
+    )
+    TEST_ASSERT_THROW(!curve25519::ExtendedPoint::tryUnpack(bad_key_bytes))
+    TEST_ASSERT_THROW(!pub_key.tryPointAdd(bad_key))
+    const auto sum = pub_key.tryPointAdd(pub_key);
+    TEST_ASSERT_THROW(sum && sum->bytes() == pub_key.pointAdd(pub_key).bytes())
+}
+
+auto testVerifyModes() -> void
+{
+    constexpr auto pub_key_bytes = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0xd7, 0x5a, 0x98, 0x01, 0x82, 0xb1, 0x0a, 0xb7, 0xd5, 0x4b, 0xfe,
+        0xd3, 0xc9, 0x64, 0x07, 0x3a, 0x0e, 0xe1, 0x72, 0xf3, 0xda, 0xa6,
+        0x23, 0x25, 0xaf, 0x02, 0x1a, 0x68, 0xf7, 0x07, 0x51, 0x1a
+    };
+    auto sig = std::array<uint8_t, ED25519_SIGNATURE_SIZE>{
+        0xe5, 0x56, 0x43, 0x00, 0xc3, 0x60, 0xac, 0x72, 0x90, 0x86, 0xe2,
+        0xcc, 0x80, 0x6e, 0x82, 0x8a, 0x84, 0x87, 0x7f, 0x1e, 0xb8, 0xe5,
+        0xd9, 0x74, 0xd8, 0x73, 0xe0, 0x65, 0x22, 0x49, 0x01, 0x55, 0x5f,
+        0xb8, 0x82, 0x15, 0x90, 0xa3, 0x3b, 0xac, 0xc6, 0x1e, 0x39, 0x70,
+        0x1c, 0xf9, 0xb4, 0x6b, 0xd2, 0x5b, 0xf5, 0xf0, 0x59, 0x5b, 0xbe,
+        0x24, 0x65, 0x51, 0x41, 0x43, 0x8e, 0x7a, 0x10, 0x0b
+    };
+    const auto msg = std::vector<uint8_t>{};
+    const auto pub_key = PublicKey(pub_key_bytes);
+    for (auto mode :
+         {VerifyMode::Legacy, VerifyMode::Rfc8032, VerifyMode::Zip215})
+    {
+        TEST_ASSERT_THROW(pub_key.verifySignature(msg, sig, mode))
+    }
+
+    // Replacing S with S + L gives a malleated signature that only the
+    // legacy rules accept.
+    constexpr auto order = std::array<uint8_t, 32>{
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7,
+        0xa2, 0xde, 0xf9, 0xde, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10
+    };
+    auto malleated = sig;
+    unsigned int carry = 0;
+    for (size_t i = 0; i < 32; ++i)
+    {
+        carry += static_cast<unsigned int>(malleated[32 + i]) + order[i];
+        malleated[32 + i] = static_cast<uint8_t>(carry);
+        carry >>= 8;
+    }
+    TEST_ASSERT_THROW(
+        pub_key.tryVerifySignature(msg, malleated, VerifyMode::Legacy) ==
+        VerifyResult::Valid
+    )
+    TEST_ASSERT_THROW(
+        pub_key.tryVerifySignature(msg, malleated, VerifyMode::Rfc8032) ==
+        VerifyResult::MalformedSignature
+    )
+    TEST_ASSERT_THROW(
+        pub_key.tryVerifySignature(msg, malleated, VerifyMode::Zip215) ==
+        VerifyResult::MalformedSignature
+    )
+
+    // With A and R both the identity and S = 0 the equation holds for any
+    // message. Strict decoding rejects the small order encodings.
+    const auto identity_key =
+        PublicKey(std::array<uint8_t, ED25519_KEY_SIZE>{0x01});
+    const auto identity_sig =
+        std::array<uint8_t, ED25519_SIGNATURE_SIZE>{0x01};
+    TEST_ASSERT_THROW(
+        identity_key.tryVerifySignature(msg, identity_sig) ==
+        VerifyResult::Valid
+    )
+    TEST_ASSERT_THROW(
+        identity_key.tryVerifySignature(
+            msg, identity_sig, VerifyMode::Zip215
+        ) == VerifyResult::Valid
+    )
+    TEST_ASSERT_THROW(
+        identity_key.tryVerifySignature(
+            msg, identity_sig, VerifyMode::Rfc8032
+        ) == VerifyResult::MalformedSignature
+    )
+    TEST_ASSERT_THROW(
+        identity_key.tryVerifySignature(msg, sig, VerifyMode::Rfc8032) ==
+        VerifyResult::MalformedPublicKey
+    )
+
+    // The ZIP-215 rules accept a non-canonical encoding (y = p + 1 = 1).
+    auto noncanonical_key_bytes = std::array<uint8_t, ED25519_KEY_SIZE>{};
+    noncanonical_key_bytes.fill(0xff);
+    noncanonical_key_bytes[0] = 0xee;
+    noncanonical_key_bytes[31] = 0x7f;
+    const auto noncanonical_key = PublicKey(noncanonical_key_bytes);
+    TEST_ASSERT_THROW(
+        noncanonical_key.tryVerifySignature(
+            msg, identity_sig, VerifyMode::Zip215
+        ) == VerifyResult::Valid
+    )
+    TEST_ASSERT_THROW(
+        noncanonical_key.tryVerifySignature(
+            msg, identity_sig, VerifyMode::Rfc8032
+        ) == VerifyResult::MalformedSignature
+    )
+}
+
 auto testBasepoint() -> void
 {
     // result of the curve25519 scalarmult ((|255| * basepoint) * basepoint)...
@@ -201,6 +356,437 @@ auto testBasepoint() -> void
     TEST_ASSERT_THROW(csk[0] == curved25519_expected)
 }
 
+auto testPointCache() -> void
+{
+    TEST_ASSERT_THROW(!PointCache::enabled())
+
+    auto keys = std::vector<PublicKey>();
+    auto sigs = std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>();
+    const auto msg = std::vector<uint8_t>{0x01, 0x02, 0x03};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        const auto prv = PrivateKey::generate();
+        keys.push_back(prv.publicKey());
+        sigs.push_back(prv.sign(msg));
+    }
+
+    // Each shard holds one entry so the keys can only be retained if they
+    // fall in different shards, repeated use of one key always hits.
+    PointCache::configure(PointCache::SHARD_COUNT, EvictionPolicy::Lru);
+    TEST_ASSERT_THROW(PointCache::enabled())
+    TEST_ASSERT_THROW(keys[0].verifySignature(msg, sigs[0]))
+    TEST_ASSERT_THROW(keys[0].verifySignature(msg, sigs[0]))
+    auto stats = PointCache::stats();
+    TEST_ASSERT_THROW(stats.hits == 1 && stats.misses == 1 && stats.size == 1)
+
+    // A failed signature check still serves the key from the cache.
+    TEST_ASSERT_THROW(!keys[0].verifySignature(msg, sigs[1]))
+    TEST_ASSERT_THROW(PointCache::stats().hits == 2)
+
+    // Keys that do not decode are never cached.
+    const auto bad_key = PublicKey(std::array<uint8_t, ED25519_KEY_SIZE>{2});
+    TEST_ASSERT_THROW(
+        bad_key.tryVerifySignature(msg, sigs[0]) ==
+        VerifyResult::MalformedPublicKey
+    )
+    TEST_ASSERT_THROW(PointCache::stats().size == 1)
+
+    PointCache::configure(1, EvictionPolicy::Fifo);
+    for (size_t i = 0; i < keys.size(); ++i)
+        TEST_ASSERT_THROW(keys[i].verifySignature(msg, sigs[i]))
+    stats = PointCache::stats();
+    TEST_ASSERT_THROW(stats.misses == keys.size() && stats.size >= 1)
+
+    PointCache::clear();
+    TEST_ASSERT_THROW(PointCache::stats().size == 0)
+    PointCache::resetStats();
+    TEST_ASSERT_THROW(PointCache::stats().misses == 0)
+
+    PointCache::configure(0);
+    TEST_ASSERT_THROW(!PointCache::enabled())
+    TEST_ASSERT_THROW(keys[2].verifySignature(msg, sigs[2]))
+    TEST_ASSERT_THROW(PointCache::stats().misses == 0)
+}
+
+auto testSignatureCache() -> void
+{
+    TEST_ASSERT_THROW(!SignatureCache::enabled())
+
+    const auto prv = PrivateKey::generate();
+    const auto pub = prv.publicKey();
+    const auto msg = std::vector<uint8_t>{0x0a, 0x0b, 0x0c};
+    auto sig = prv.sign(msg);
+
+    SignatureCache::configure(1000);
+    TEST_ASSERT_THROW(SignatureCache::enabled())
+    TEST_ASSERT_THROW(SignatureCache::stats().capacity == 32)
+
+    TEST_ASSERT_THROW(pub.verifySignature(msg, sig))
+    auto stats = SignatureCache::stats();
+    TEST_ASSERT_THROW(stats.hits == 0 && stats.misses == 1)
+    TEST_ASSERT_THROW(pub.verifySignature(msg, sig))
+    TEST_ASSERT_THROW(SignatureCache::stats().hits == 1)
+
+    // Entries are specific to the verification rules.
+    TEST_ASSERT_THROW(pub.verifySignature(msg, sig, VerifyMode::Zip215))
+    TEST_ASSERT_THROW(SignatureCache::stats().hits == 1)
+
+    // Invalid signatures are never cached.
+    sig[0] ^= 0x01;
+    TEST_ASSERT_THROW(!pub.verifySignature(msg, sig))
+    TEST_ASSERT_THROW(!pub.verifySignature(msg, sig))
+    TEST_ASSERT_THROW(SignatureCache::stats().hits == 1)
+    sig[0] ^= 0x01;
+
+    SignatureCache::clear();
+    TEST_ASSERT_THROW(pub.verifySignature(msg, sig))
+    TEST_ASSERT_THROW(SignatureCache::stats().hits == 1)
+
+    SignatureCache::configure(0);
+    TEST_ASSERT_THROW(!SignatureCache::enabled())
+    TEST_ASSERT_THROW(pub.verifySignature(msg, sig))
+    TEST_ASSERT_THROW(SignatureCache::stats().misses == 0)
+}
+
+// Replacing the table while other threads verify must not touch freed
+// memory. Best run under ASan or TSan.
+auto testSignatureCacheReconfigure() -> void
+{
+    const auto prv = PrivateKey::generate();
+    const auto pub = prv.publicKey();
+    const auto msg = std::vector<uint8_t>{0x0d, 0x0e, 0x0f};
+    const auto sig = prv.sign(msg);
+
+    auto stop = std::atomic<bool>{false};
+    auto failures = std::atomic<size_t>{0};
+    auto readers = std::vector<std::thread>();
+    for (size_t i = 0; i < 4; ++i)
+        readers.emplace_back(
+            [&]
+            {
+                while (!stop.load())
+                    if (!pub.verifySignature(msg, sig)) ++failures;
+            }
+        );
+
+    for (size_t i = 0; i < 200; ++i)
+    {
+        SignatureCache::configure(i % 3 == 0 ? 0 : 1024 << (i % 4));
+        std::this_thread::yield();
+    }
+    stop = true;
+    for (auto& reader : readers) reader.join();
+
+    SignatureCache::configure(0);
+    TEST_ASSERT_THROW(failures == 0)
+}
+
+auto testThreadPool() -> void
+{
+    auto pool = ThreadPool(4);
+    TEST_ASSERT_THROW(pool.size() == 4)
+
+    auto counts = std::vector<std::atomic<int>>(1000);
+    pool.parallelFor(counts.size(), [&](size_t i) { counts[i] += 1; });
+    for (const auto& c : counts) TEST_ASSERT_THROW(c == 1)
+
+    // Nested use from within a task must not deadlock.
+    auto total = std::atomic<size_t>{0};
+    pool.parallelFor(
+        8,
+        [&](size_t)
+        {
+            pool.parallelFor(
+                8, [&](size_t j) { total += j; }
+            );
+        }
+    );
+    TEST_ASSERT_THROW(total == 8 * 28)
+
+    auto threw = false;
+    try
+    {
+        pool.parallelFor(
+            16,
+            [](size_t i)
+            {
+                if (i == 5) throw std::runtime_error("task failed");
+            }
+        );
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT_THROW(threw)
+}
+
+auto testBatchVerifier() -> void
+{
+    constexpr auto count = size_t{150};
+    auto keys = std::vector<PublicKey>();
+    auto msgs = std::vector<std::vector<uint8_t>>();
+    auto sigs = std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto prv = PrivateKey::generate();
+        msgs.push_back(std::vector<uint8_t>(i % 40, static_cast<uint8_t>(i)));
+        keys.push_back(prv.publicKey());
+        sigs.push_back(prv.sign(msgs.back()));
+    }
+
+    // Corrupt a few signatures in different chunks, including one with an
+    // out of range S and one with an R that does not decode.
+    sigs[3][40] ^= 0x01;
+    sigs[70][63] |= 0xe0;
+    sigs[149][0] = 0x02;
+    std::fill_n(sigs[149].begin() + 1, 31, uint8_t{0});
+
+    auto pool = ThreadPool(3);
+    for (auto mode :
+         {VerifyMode::Zip215, VerifyMode::Rfc8032, VerifyMode::Legacy})
+    {
+        auto verifier = BatchVerifier(pool, mode);
+        for (size_t i = 0; i < count; ++i)
+            verifier.add(keys[i], msgs[i], sigs[i]);
+        TEST_ASSERT_THROW(verifier.size() == count)
+
+        const auto results = verifier.verify();
+        TEST_ASSERT_THROW(results.size() == count)
+        for (size_t i = 0; i < count; ++i)
+        {
+            const auto expected = keys[i].tryVerifySignature(
+                                      msgs[i], sigs[i], mode
+                                  ) == VerifyResult::Valid;
+            TEST_ASSERT_THROW(results[i] == expected)
+            TEST_ASSERT_THROW(results[i] == (i != 3 && i != 70 && i != 149))
+        }
+    }
+
+    // A verifier may also own its pool.
+    auto verifier = BatchVerifier();
+    verifier.add(keys[0], msgs[0], sigs[0]);
+    TEST_ASSERT_THROW(verifier.verify() == std::vector<bool>{true})
+    verifier.clear();
+    TEST_ASSERT_THROW(verifier.verify().empty())
+}
+
+/// Minimal eagerly started coroutine type for testing awaitables.
+struct DetachedTask
+{
+    struct promise_type
+    {
+        auto get_return_object() -> DetachedTask { return {}; }
+        auto initial_suspend() noexcept -> std::suspend_never { return {}; }
+        auto final_suspend() noexcept -> std::suspend_never { return {}; }
+        auto return_void() -> void {}
+        auto unhandled_exception() -> void { std::terminate(); }
+    };
+};
+
+auto awaitVerification(
+    VerificationService& service,
+    const PublicKey& key,
+    std::vector<uint8_t> msg,
+    std::array<uint8_t, ED25519_SIGNATURE_SIZE> sig,
+    std::promise<bool>& out
+) -> DetachedTask
+{
+    out.set_value(co_await service.submit(key, msg, sig));
+}
+
+auto testVerificationService() -> void
+{
+    constexpr auto count = size_t{40};
+    auto keys = std::vector<PublicKey>();
+    auto msgs = std::vector<std::vector<uint8_t>>();
+    auto sigs = std::vector<std::array<uint8_t, ED25519_SIGNATURE_SIZE>>();
+    for (size_t i = 0; i < count; ++i)
+    {
+        const auto prv = PrivateKey::generate();
+        msgs.push_back(std::vector<uint8_t>(8, static_cast<uint8_t>(i)));
+        keys.push_back(prv.publicKey());
+        sigs.push_back(prv.sign(msgs.back()));
+    }
+    sigs[7][1] ^= 0x40;
+
+    auto pool = ThreadPool(2);
+    auto options = VerificationService::Options{};
+    options.maxBatch = 16;
+    options.maxDelay = std::chrono::milliseconds(2);
+    auto service = VerificationService(pool, options);
+
+    // Futures, with a partial final batch dispatched by the deadline
+    auto futures = std::vector<std::future<bool>>();
+    for (size_t i = 0; i < count; ++i)
+        futures.push_back(service.submitFuture(keys[i], msgs[i], sigs[i]));
+    for (size_t i = 0; i < count; ++i)
+        TEST_ASSERT_THROW(futures[i].get() == (i != 7))
+
+    // Coroutines
+    auto promises = std::vector<std::promise<bool>>(4);
+    for (size_t i = 0; i < promises.size(); ++i)
+        awaitVerification(
+            service, keys[i + 5], msgs[i + 5], sigs[i + 5], promises[i]
+        );
+    for (size_t i = 0; i < promises.size(); ++i)
+        TEST_ASSERT_THROW(promises[i].get_future().get() == (i + 5 != 7))
+
+    // Submissions still queued are completed by the destructor.
+    auto pending = std::future<bool>();
+    {
+        options.maxDelay = std::chrono::hours(1);
+        auto lazy = VerificationService(pool, options);
+        pending = lazy.submitFuture(keys[0], msgs[0], sigs[0]);
+    }
+    TEST_ASSERT_THROW(pending.get())
+
+    // A throwing completion does not hold up the rest of its batch, and
+    // submissions made while the service shuts down are refused.
+    auto rejected = false;
+    {
+        auto lazy = VerificationService(pool, options);
+        lazy.submitCallback(
+            keys[1], msgs[1], sigs[1],
+            [](std::exception_ptr, bool) { throw std::runtime_error("done"); }
+        );
+        lazy.submitCallback(
+            keys[2], msgs[2], sigs[2],
+            [&](std::exception_ptr, bool)
+            {
+                try
+                {
+                    [[maybe_unused]] const auto late =
+                        lazy.submitFuture(keys[3], msgs[3], sigs[3]);
+                }
+                catch (const std::logic_error&)
+                {
+                    rejected = true;
+                }
+            }
+        );
+    }
+    TEST_ASSERT_THROW(rejected)
+}
+
+auto testSecureByteArray() -> void
+{
+    const auto in_use = SecureArena::slotsInUse();
+    {
+        // Fill the first region so that the later keys need a new one.
+        auto keys = std::vector<KeyByteArray>(SecureArena::SLOT_COUNT + 8);
+        for (size_t i = 0; i < keys.size(); ++i)
+            keys[i][0] = static_cast<uint8_t>(i);
+        TEST_ASSERT_THROW(
+            SecureArena::slotsInUse() == in_use + SecureArena::SLOT_COUNT + 8
+        )
+        for (size_t i = 0; i < keys.size(); ++i)
+            TEST_ASSERT_THROW(keys[i][0] == static_cast<uint8_t>(i))
+
+        auto copy = keys.back();
+        TEST_ASSERT_THROW(copy == keys.back())
+        copy[1] ^= 0x01;
+        TEST_ASSERT_THROW(!(copy == keys.back()))
+    }
+    TEST_ASSERT_THROW(SecureArena::slotsInUse() == in_use)
+
+    // Released slots are wiped before reuse.
+    auto key = ExtKeyByteArray{};
+    TEST_ASSERT_THROW(key == (std::array<uint8_t, ED25519_EXTENDED_KEY_SIZE>{}))
+}
+
+auto testPerfCounters() -> void
+{
+    const auto prv_key = PrivateKey::generate();
+    const auto pub_key = prv_key.publicKey();
+    const auto msg = std::vector<uint8_t>{'p', 'e', 'r', 'f'};
+
+    // Nothing is recorded while collection is disabled.
+    PerfCounters::setEnabled(false);
+    PerfCounters::reset();
+    auto sig = prv_key.sign(msg);
+    TEST_ASSERT_THROW(PerfCounters::stats(Operation::Sign).calls == 0)
+
+    PerfCounters::setEnabled(true);
+    sig = prv_key.sign(msg);
+    TEST_ASSERT_THROW(pub_key.verifySignature(msg, sig))
+    PerfCounters::setEnabled(false);
+
+    // Without instrumentation or counter access the totals stay empty.
+    const auto sign = PerfCounters::stats(Operation::Sign);
+    const auto verify = PerfCounters::stats(Operation::Verify);
+    const auto dsm = PerfCounters::stats(Operation::DoubleScalarMul);
+    if (PerfCounters::available())
+    {
+        TEST_ASSERT_THROW(sign.calls == 1 && verify.calls == 1)
+        TEST_ASSERT_THROW(dsm.calls == 1)
+        TEST_ASSERT_THROW(sign.cycles > 0 && sign.instructions > 0)
+        TEST_ASSERT_THROW(verify.cycles > dsm.cycles / 2)
+    }
+    else
+    {
+        TEST_ASSERT_THROW(sign.calls == 0 && verify.calls == 0)
+    }
+    TEST_ASSERT_THROW(operationName(Operation::VrfProve) == "vrf_prove")
+
+    PerfCounters::reset();
+    TEST_ASSERT_THROW(PerfCounters::stats(Operation::Verify).calls == 0)
+}
+
+auto testLatencyRecorder() -> void
+{
+    const auto prv_key = PrivateKey::generate();
+    const auto pub_key = prv_key.publicKey();
+    const auto msg = std::vector<uint8_t>{'l', 'a', 't'};
+
+    LatencyRecorder::setEnabled(false);
+    LatencyRecorder::reset();
+    auto sig = prv_key.sign(msg);
+    TEST_ASSERT_THROW(LatencyRecorder::summary(Operation::Sign).count == 0)
+
+    LatencyRecorder::setEnabled(true);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        sig = prv_key.sign(msg);
+        TEST_ASSERT_THROW(pub_key.verifySignature(msg, sig))
+    }
+    LatencyRecorder::setEnabled(false);
+
+    // Operations only time themselves when built with VIPER25519_LATENCY.
+    const auto sign = LatencyRecorder::summary(Operation::Sign);
+    const auto verify = LatencyRecorder::summary(Operation::Verify);
+    if (LatencyRecorder::available())
+    {
+        TEST_ASSERT_THROW(sign.count == 100 && verify.count == 100)
+        TEST_ASSERT_THROW(sign.min_ns > 0 && sign.min_ns <= sign.p50_ns)
+        TEST_ASSERT_THROW(sign.p50_ns <= sign.p90_ns)
+        TEST_ASSERT_THROW(sign.p90_ns <= sign.p99_ns)
+        TEST_ASSERT_THROW(sign.p99_ns <= sign.p999_ns)
+        TEST_ASSERT_THROW(sign.p999_ns <= sign.max_ns)
+        TEST_ASSERT_THROW(sign.min_ns <= sign.mean_ns)
+        TEST_ASSERT_THROW(sign.mean_ns <= sign.max_ns)
+
+        const auto text = LatencyRecorder::dumpText();
+        const auto json = LatencyRecorder::dumpJson();
+        TEST_ASSERT_THROW(text.find("sign") != std::string::npos)
+        TEST_ASSERT_THROW(json.find("\"verify\"") != std::string::npos)
+    }
+    else
+    {
+        TEST_ASSERT_THROW(sign.count == 0 && verify.count == 0)
+    }
+
+    LatencyRecorder::reset();
+    TEST_ASSERT_THROW(LatencyRecorder::summary(Operation::Verify).count == 0)
+    TEST_ASSERT_THROW(LatencyRecorder::percentile(Operation::Verify, 0.5) == 0)
+
+    // A direct record lands in the bucket holding the value.
+    LatencyRecorder::record(Operation::KeyDerive, 1000);
+    const auto derive = LatencyRecorder::summary(Operation::KeyDerive);
+    TEST_ASSERT_THROW(derive.count == 1 && derive.p50_ns == derive.max_ns)
+    LatencyRecorder::reset();
+}
+
 auto main() -> int
 {
     testKeyGen();
@@ -209,6 +795,17 @@ auto main() -> int
     testBasicSignature();
     testAdvancedSignature();
     testKeyAdd();
+    testNonThrowingApi();
+    testVerifyModes();
     testBasepoint();
+    testSecureByteArray();
+    testPointCache();
+    testSignatureCache();
+    testSignatureCacheReconfigure();
+    testThreadPool();
+    testBatchVerifier();
+    testVerificationService();
+    testPerfCounters();
+    testLatencyRecorder();
     return 0;
 }
\ No newline at end of file
@@ -82,6 +82,26 @@ auto test_expand256_modm() -> void
     TEST_ASSERT_THROW(a == a_donna)
 }
 
+auto test_expand256_modm_borrow() -> void
+{
+    // A 512 bit input where the Barrett estimate exceeds the low 264 bits,
+    // so the final subtraction borrows out of the top limb.
+    constexpr auto x = std::array<uint8_t, 64>{
+        0x88, 0xc7, 0x13, 0x2c, 0x67, 0x87, 0xdb, 0x09, 0x4c, 0x1f, 0x4f,
+        0x6d, 0xeb, 0x5e, 0xf0, 0x21, 0x5b, 0x86, 0x50, 0x91, 0x58, 0x16,
+        0x91, 0xce, 0x3d, 0xcd, 0xa4, 0xeb, 0x93, 0x50, 0xa2, 0x0e, 0x00,
+        0xef, 0x4d, 0xac, 0xdb, 0x90, 0xf0, 0x65, 0xc3, 0x2f, 0x92, 0xe8,
+        0xfc, 0xee, 0x27, 0x50, 0xc0, 0x9d, 0x52, 0xa5, 0x2b, 0x7d, 0x4a,
+        0xd0, 0xbb, 0x0c, 0x15, 0x5c, 0x94, 0xaf, 0x6a, 0x79};
+    constexpr auto x_mod_l = std::array<uint8_t, 32>{
+        0xf0, 0x96, 0x96, 0x02, 0x4e, 0x30, 0xc7, 0x90, 0x30, 0x1e, 0xfa,
+        0xea, 0x94, 0xc4, 0xf0, 0xa4, 0x11, 0xf8, 0x30, 0xdd, 0xee, 0xe9,
+        0xbd, 0x28, 0x9e, 0x4a, 0xae, 0x7b, 0x03, 0x0e, 0x28, 0x00};
+
+    const auto a = curve25519::bignum25519::expand256_modm(x);
+    TEST_ASSERT_THROW(curve25519::bignum25519::contract256_modm(a) == x_mod_l)
+}
+
 auto test_bignum25519_expand() -> void
 {
     constexpr auto table = std::array<uint8_t, 96>{
@@ -243,6 +263,7 @@ auto main() -> int
     test_contract256_window4_modm();
     test_contract256_slidingwindow_modm();
     test_expand256_modm();
+    test_expand256_modm_borrow();
     test_bignum25519_expand();
     test_bignum25519_swap_conditional();
     test_bignum25519_neg();
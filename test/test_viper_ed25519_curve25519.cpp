@@ -1,5 +1,6 @@
 
 #include <viper25519/curve25519.hpp>
+#include <viper25519/op_counters.hpp>
 
 #include "testing.hpp"
 
@@ -507,6 +508,121 @@ auto test_ExtendedPoint_doubleScalarMultiple() -> void
     TEST_ASSERT_THROW(d1.t() == t_donna)
 }
 
+auto test_ExtendedPoint_packBatch() -> void
+{
+    auto points = std::vector<ExtendedPoint>();
+    for (uint64_t i = 1; i <= 5; ++i)
+    {
+        const auto s = bignum25519{i * 0x1234567, i, 0, 0, 0};
+        points.push_back(ExtendedPoint::multiplyBasepointByScalar(s));
+    }
+
+    const auto packed = ExtendedPoint::packBatch(points);
+    TEST_ASSERT_THROW(packed.size() == points.size())
+    for (size_t i = 0; i < points.size(); ++i)
+        TEST_ASSERT_THROW(packed[i] == points[i].pack())
+
+    TEST_ASSERT_THROW(ExtendedPoint::packBatch({}).empty())
+}
+
+auto test_ExtendedPoint_multiScalarMultiple() -> void
+{
+    auto scalar = [](uint8_t seed)
+    {
+        auto bytes = std::array<uint8_t, 32>{};
+        for (size_t i = 0; i < bytes.size(); ++i)
+            bytes[i] = static_cast<uint8_t>(seed * (i + 3) + 11);
+        return bignum25519::expand256_modm(bytes);
+    };
+
+    const auto b = ExtendedPoint::basepoint();
+    const auto q = scalar(7);
+    const auto p = ExtendedPoint::multiplyBasepointByScalar(q);
+
+    // Agrees with the double scalar multiplication
+    const auto s1 = scalar(1);
+    const auto s2 = scalar(2);
+    const auto scalars = std::vector<bignum25519>{s1, s2};
+    const auto points = std::vector<ExtendedPoint>{p, b};
+    TEST_ASSERT_THROW(
+        ExtendedPoint::multiScalarMultiple(scalars, points).pack() ==
+        p.doubleScalarMultiple(s1, s2).pack()
+    )
+
+    // [a]([q]B) = [aq]B
+    const auto a = scalar(3);
+    const auto single = ExtendedPoint::multiScalarMultiple(
+        std::vector<bignum25519>{a}, std::vector<ExtendedPoint>{p}
+    );
+    TEST_ASSERT_THROW(
+        single.pack() == ExtendedPoint::multiplyBasepointByScalar(
+                             bignum25519::mul256_modm(a, q)
+                         )
+                             .pack()
+    )
+
+    TEST_ASSERT_THROW(ExtendedPoint::multiScalarMultiple({}, {}).isIdentity())
+}
+
+auto test_ExtendedPoint_scalarMultiple() -> void
+{
+    auto bytes = std::array<uint8_t, 32>{};
+    for (size_t i = 0; i < bytes.size(); ++i)
+        bytes[i] = static_cast<uint8_t>(i * 29 + 5);
+    const auto s = bignum25519::expand256_modm(bytes);
+    const auto q = bignum25519::expand256_modm(std::array<uint8_t, 32>{9});
+
+    // [s]B through the generic table agrees with the fixed base routine
+    const auto b = ExtendedPoint::basepoint();
+    TEST_ASSERT_THROW(
+        b.scalarMultiple(s).pack() ==
+        ExtendedPoint::multiplyBasepointByScalar(s).pack()
+    )
+
+    // [s]([9]B) = [9s]B, and [s]p + [s](-p) is the identity
+    const auto p = ExtendedPoint::multiplyBasepointByScalar(q);
+    TEST_ASSERT_THROW(
+        p.scalarMultiple(s).pack() == ExtendedPoint::multiplyBasepointByScalar(
+                                          bignum25519::mul256_modm(s, q)
+                                      )
+                                          .pack()
+    )
+    const auto sum = p.scalarMultiple(s) + p.negate().scalarMultiple(s);
+    TEST_ASSERT_THROW(sum.isIdentity())
+
+    // [0]p is the identity
+    TEST_ASSERT_THROW(p.scalarMultiple(bignum25519{}).isIdentity())
+}
+
+auto test_ExtendedPoint_smallOrder() -> void
+{
+    using ed25519::has_small_order;
+    using ed25519::is_canonical_point;
+    using ed25519::is_canonical_scalar;
+    const auto &table = ed25519::small_order_points;
+
+    // The canonical entries of the small order table decode to points that
+    // vanish once the cofactor is cleared, the basepoint does not.
+    for (size_t i = 0; i < 5; ++i)
+    {
+        const auto p = ExtendedPoint::tryUnpack(table[i]);
+        TEST_ASSERT_THROW(p && p->mulByCofactor().isIdentity())
+        TEST_ASSERT_THROW(has_small_order(table[i]))
+        TEST_ASSERT_THROW(is_canonical_point(table[i]))
+    }
+    TEST_ASSERT_THROW(!is_canonical_point(table[5]))
+    TEST_ASSERT_THROW(!is_canonical_point(table[6]))
+
+    const auto b = ExtendedPoint::basepoint();
+    TEST_ASSERT_THROW(!b.mulByCofactor().isIdentity())
+    TEST_ASSERT_THROW(!has_small_order(b.pack()))
+
+    auto order = ed25519::group_order_bytes;
+    TEST_ASSERT_THROW(!is_canonical_scalar(order))
+    order[0] -= 1;
+    TEST_ASSERT_THROW(is_canonical_scalar(order))
+}
+
 auto test_CompletedPoint_toExtended() -> void
 {
     const auto p1 = curve25519::CompletedPoint{std::array<bignum25519, 4>{
@@ -545,6 +661,52 @@ auto test_CompletedPoint_toExtended() -> void
     TEST_ASSERT_THROW(r.t() == r1.t())
 }
 
+auto test_OpCounters() -> void
+{
+    using ed25519::OpCounters;
+
+    auto points = std::vector<ExtendedPoint>();
+    for (uint64_t i = 1; i <= 8; ++i)
+    {
+        const auto s = bignum25519{i * 0x7654321, i, 0, 0, 0};
+        points.push_back(ExtendedPoint::multiplyBasepointByScalar(s));
+    }
+
+    OpCounters::reset();
+    const auto before = OpCounters::snapshot();
+    (void)points[0].mulByCofactor();
+    const auto cofactor = OpCounters::snapshot() - before;
+
+    OpCounters::reset();
+    (void)ExtendedPoint::packBatch(points);
+    const auto batch = OpCounters::snapshot();
+
+    OpCounters::reset();
+    (void)points[0].pack();
+    const auto single = OpCounters::snapshot();
+
+    if (!OpCounters::enabled())
+    {
+        TEST_ASSERT_THROW(cofactor == ed25519::OpCounts{})
+        TEST_ASSERT_THROW(batch == ed25519::OpCounts{})
+        return;
+    }
+
+    // Three doublings, two ending in projective and one in extended form.
+    TEST_ASSERT_THROW(cofactor.point_double == 3)
+    TEST_ASSERT_THROW(cofactor.point_convert == 3)
+    TEST_ASSERT_THROW(cofactor.field_square == 12)
+    TEST_ASSERT_THROW(cofactor.field_mul == 10)
+    TEST_ASSERT_THROW(cofactor.field_invert == 0)
+
+    // Batch packing shares one inversion between all points.
+    TEST_ASSERT_THROW(batch.field_invert == 1)
+    TEST_ASSERT_THROW(batch.field_contract == 2 * points.size())
+    TEST_ASSERT_THROW(single.field_invert == 1)
+    TEST_ASSERT_THROW(single.field_contract == 2)
+    TEST_ASSERT_THROW(batch.field_square == single.field_square)
+}
+
 auto main() -> int
 {
     test_curve25519_move_conditional_bytes();
@@ -559,6 +721,11 @@ auto main() -> int
     test_ExtendedPoint_multiplyBasepointByScalar();
     test_ExtendedPoint_unpack();
     test_ExtendedPoint_doubleScalarMultiple();
+    test_ExtendedPoint_packBatch();
+    test_ExtendedPoint_multiScalarMultiple();
+    test_ExtendedPoint_scalarMultiple();
+    test_ExtendedPoint_smallOrder();
+    test_OpCounters();
 
     test_CompletedPoint_toExtended();
 
@@ -1,6 +1,15 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <limits>
+#include <stdexcept>
+
 #include <viper25519/ed25519.hpp>
 #include <test/testing.hpp>
 
+// The generator is private code so the header is included directly.
+#include "src/random.hpp"
+
 using namespace ed25519;
 
 auto testKeyGen() -> void
@@ -17,6 +26,96 @@ auto testExtendedKeyGen() -> void
     TEST_ASSERT_THROW(ext_key.isValid());
 }
 
+auto testBatchKeyGen() -> void
+{
+    const auto keys = PrivateKey::generateBatch(100);
+    TEST_ASSERT_THROW(keys.size() == 100);
+    for (const auto& [skey, pkey] : keys)
+    {
+        TEST_ASSERT_THROW(skey.isValid());
+        TEST_ASSERT_THROW(skey.publicKey().bytes() == pkey.bytes());
+    }
+    TEST_ASSERT_THROW(PrivateKey::generateBatch(0).empty());
+
+    // Batches larger than one arena region stay in the arena.
+    const auto in_use = SecureArena::slotsInUse();
+    {
+        const auto many =
+            PrivateKey::generateBatch(SecureArena::SLOT_COUNT + 1);
+        TEST_ASSERT_THROW(
+            SecureArena::slotsInUse() == in_use + SecureArena::SLOT_COUNT + 1
+        );
+        TEST_ASSERT_THROW(many.back().first.isValid());
+    }
+    TEST_ASSERT_THROW(SecureArena::slotsInUse() == in_use);
+
+    // So do batches that need more than 64 regions of the first size.
+    {
+        constexpr auto count = 64 * SecureArena::SLOT_COUNT + 1;
+        const auto many = PrivateKey::generateBatch(count);
+        TEST_ASSERT_THROW(SecureArena::slotsInUse() == in_use + count);
+        TEST_ASSERT_THROW(many.back().first.isValid());
+    }
+    TEST_ASSERT_THROW(SecureArena::slotsInUse() == in_use);
+
+    auto threw = false;
+    try
+    {
+        [[maybe_unused]] const auto none =
+            PrivateKey::generateBatch(std::numeric_limits<size_t>::max());
+    }
+    catch (const std::length_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT_THROW(threw);
+}
+
+auto testChaCha20Block() -> void
+{
+    // RFC 8439, section 2.3.2
+    auto key = std::array<uint8_t, 32>{};
+    for (size_t i = 0; i < key.size(); ++i) key[i] = static_cast<uint8_t>(i);
+    constexpr auto nonce = std::array<uint8_t, 12>{
+        0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00};
+    constexpr auto expected = std::array<uint8_t, 64>{
+        0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd,
+        0x1f, 0xa3, 0x20, 0x71, 0xc4, 0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0,
+        0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e, 0xd2,
+        0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05,
+        0xd9, 0x8b, 0x02, 0xa2, 0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e,
+        0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e};
+    TEST_ASSERT_THROW(chacha20_block(key, 1, nonce) == expected);
+}
+
+auto testRandomReseed() -> void
+{
+    auto& rng = ChaCha20Rng::local();
+    auto a = std::array<uint8_t, 32>{};
+    auto b = std::array<uint8_t, 32>{};
+    rng.randomize(a);
+    reseedRandomGenerator();
+    rng.randomize(b);
+    TEST_ASSERT_THROW(a != b);
+
+    // A forked child must not repeat the output of its parent.
+    int fds[2];
+    TEST_ASSERT_THROW(pipe(fds) == 0);
+    const auto pid = fork();
+    if (pid == 0)
+    {
+        rng.randomize(a);
+        _exit(write(fds[1], a.data(), a.size()) == 32 ? 0 : 1);
+    }
+    rng.randomize(b);
+    auto c = std::array<uint8_t, 32>{};
+    TEST_ASSERT_THROW(read(fds[0], c.data(), c.size()) == 32);
+    waitpid(pid, nullptr, 0);
+    close(fds[0]);
+    close(fds[1]);
+    TEST_ASSERT_THROW(b != c);
+}
+
 auto testPublicKeyGen() -> void
 {
     constexpr auto ext_prv_key_bytes =
@@ -54,6 +153,9 @@ auto main() -> int
 {
     testKeyGen();
     testExtendedKeyGen();
+    testBatchKeyGen();
+    testChaCha20Block();
+    testRandomReseed();
     testPublicKeyGen();
     return 0;
 }
\ No newline at end of file
@@ -79,9 +79,255 @@ auto testAdvanced() -> void
     ))
 }
 
+auto testBatch() -> void
+{
+    constexpr auto prv_key_bytes = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0x9d, 0x61, 0xb1, 0x9d, 0xef, 0xfd, 0x5a, 0x60, 0xba, 0x84, 0x4a,
+        0xf4, 0x92, 0xec, 0x2c, 0xc4, 0x44, 0x49, 0xc5, 0x69, 0x7b, 0x32,
+        0x69, 0x19, 0x70, 0x3b, 0xac, 0x03, 0x1c, 0xae, 0x7f, 0x60};
+    const auto prv_key = PrivateKey(prv_key_bytes);
+    const auto pub_key = prv_key.publicKey();
+
+    // Batch signatures must match signing each message individually
+    auto msgs = std::vector<std::vector<uint8_t>>();
+    for (uint8_t i = 0; i < 17; ++i)
+        msgs.push_back(std::vector<uint8_t>(i, static_cast<uint8_t>(i * 7)));
+    const auto views =
+        std::vector<std::span<const uint8_t>>(msgs.begin(), msgs.end());
+
+    const auto sigs = prv_key.signBatch(views);
+    TEST_ASSERT_THROW(sigs.size() == msgs.size())
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        TEST_ASSERT_THROW(sigs[i] == prv_key.sign(msgs[i]))
+        TEST_ASSERT_THROW(pub_key.verifySignature(msgs[i], sigs[i]))
+    }
+
+    TEST_ASSERT_THROW(prv_key.signBatch({}).empty())
+}
+
+auto testSegments() -> void
+{
+    constexpr auto prv_key_bytes = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0x72, 0xd4, 0xa5, 0x64, 0xca, 0x15, 0x49, 0x9b, 0x5e, 0x4e, 0x75,
+        0xd8, 0xac, 0x0f, 0x28, 0x21, 0x7d, 0x32, 0x11, 0x4a, 0x0c, 0x64,
+        0x9a, 0x7c, 0x8e, 0xaa, 0xdd, 0x0c, 0xc7, 0x8c, 0x52, 0x0b};
+    const auto prv_key = PrivateKey(prv_key_bytes);
+    const auto pub_key = prv_key.publicKey();
+
+    auto msg = std::vector<uint8_t>(300);
+    for (size_t i = 0; i < msg.size(); ++i)
+        msg[i] = static_cast<uint8_t>(i * 31);
+    const auto whole = std::span<const uint8_t>(msg);
+
+    // Header, empty, body and witness segments sign as the whole message
+    const auto segments = std::vector<std::span<const uint8_t>>{
+        whole.subspan(0, 20), whole.subspan(20, 0), whole.subspan(20, 200),
+        whole.subspan(220)};
+    const auto sig = prv_key.sign(segments);
+    TEST_ASSERT_THROW(sig == prv_key.sign(msg))
+    TEST_ASSERT_THROW(sig == prv_key.extend().sign(segments))
+
+    // Verification is independent of how the message is split
+    const auto other_split = std::vector<std::span<const uint8_t>>{
+        whole.subspan(0, 1), whole.subspan(1)};
+    TEST_ASSERT_THROW(pub_key.verifySignature(segments, sig))
+    TEST_ASSERT_THROW(pub_key.verifySignature(other_split, sig))
+    TEST_ASSERT_THROW(
+        pub_key.tryVerifySignature(other_split, sig, VerifyMode::Rfc8032) ==
+        VerifyResult::Valid
+    )
+
+    // Dropping a segment changes the message
+    const auto missing = std::vector<std::span<const uint8_t>>{
+        segments[0], segments[2]};
+    TEST_ASSERT_THROW(!pub_key.verifySignature(missing, sig))
+}
+
+auto testStreaming() -> void
+{
+    const auto prv_key = PrivateKey::generate();
+    const auto pub_key = prv_key.publicKey();
+
+    auto msg = std::vector<uint8_t>(100000);
+    for (size_t i = 0; i < msg.size(); ++i)
+        msg[i] = static_cast<uint8_t>(i ^ (i >> 8));
+    auto sig = prv_key.sign(msg);
+
+    // Feed the message in uneven chunks
+    auto feed = [&msg](Verifier& verifier)
+    {
+        auto pos = size_t{0};
+        for (size_t n = 1; pos < msg.size(); n = n * 3 + 1)
+        {
+            const auto len = std::min(n % 4096, msg.size() - pos);
+            verifier.update({msg.data() + pos, len});
+            pos += len;
+        }
+    };
+
+    auto verifier = Verifier();
+    for (auto mode :
+         {VerifyMode::Legacy, VerifyMode::Rfc8032, VerifyMode::Zip215})
+    {
+        verifier.init(pub_key, sig, mode);
+        feed(verifier);
+        TEST_ASSERT_THROW(verifier.final())
+    }
+
+    // The same verifier can be reused for a different signature
+    sig[5] ^= 0x10;
+    verifier.init(pub_key, sig);
+    feed(verifier);
+    TEST_ASSERT_THROW(verifier.tryFinal() == VerifyResult::Invalid)
+    sig[5] ^= 0x10;
+
+    // Malformed signatures are detected at init and reported by final
+    sig[63] |= 0xe0;
+    verifier.init(pub_key, sig);
+    feed(verifier);
+    auto threw = false;
+    try
+    {
+        (void)verifier.final();
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT_THROW(threw)
+
+    // The verifier must be initialised before use
+    threw = false;
+    try
+    {
+        verifier.update(msg);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT_THROW(threw)
+
+    // A moved-from verifier is uninitialised and can be initialised again
+    auto moved = std::move(verifier);
+    TEST_ASSERT_THROW(verifier.tryFinal() == VerifyResult::Invalid)
+    threw = false;
+    try
+    {
+        verifier.update(msg);
+    }
+    catch (const std::logic_error&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT_THROW(threw)
+    verifier.init(pub_key, prv_key.sign(msg));
+    feed(verifier);
+    TEST_ASSERT_THROW(verifier.final())
+}
+
+auto testPrehashAndContext() -> void
+{
+    // RFC 8032 section 7.3, Ed25519ph of "abc"
+    constexpr auto ph_prv = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0x83, 0x3f, 0xe6, 0x24, 0x09, 0x23, 0x7b, 0x9d, 0x62, 0xec, 0x77,
+        0x58, 0x75, 0x20, 0x91, 0x1e, 0x9a, 0x75, 0x9c, 0xec, 0x1d, 0x19,
+        0x75, 0x5b, 0x7d, 0xa9, 0x01, 0xb9, 0x6d, 0xca, 0x3d, 0x42};
+    constexpr auto ph_pub = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0xec, 0x17, 0x2b, 0x93, 0xad, 0x5e, 0x56, 0x3b, 0xf4, 0x93, 0x2c,
+        0x70, 0xe1, 0x24, 0x50, 0x34, 0xc3, 0x54, 0x67, 0xef, 0x2e, 0xfd,
+        0x4d, 0x64, 0xeb, 0xf8, 0x19, 0x68, 0x34, 0x67, 0xe2, 0xbf};
+    constexpr auto ph_sig = std::array<uint8_t, ED25519_SIGNATURE_SIZE>{
+        0x98, 0xa7, 0x02, 0x22, 0xf0, 0xb8, 0x12, 0x1a, 0xa9, 0xd3, 0x0f,
+        0x81, 0x3d, 0x68, 0x3f, 0x80, 0x9e, 0x46, 0x2b, 0x46, 0x9c, 0x7f,
+        0xf8, 0x76, 0x39, 0x49, 0x9b, 0xb9, 0x4e, 0x6d, 0xae, 0x41, 0x31,
+        0xf8, 0x50, 0x42, 0x46, 0x3c, 0x2a, 0x35, 0x5a, 0x20, 0x03, 0xd0,
+        0x62, 0xad, 0xf5, 0xaa, 0xa1, 0x0b, 0x8c, 0x61, 0xe6, 0x36, 0x06,
+        0x2a, 0xaa, 0xd1, 0x1c, 0x2a, 0x26, 0x08, 0x34, 0x06};
+
+    const auto ph_key = PrivateKey(ph_prv);
+    const auto ph_pub_key = PublicKey(ph_pub);
+    const auto abc = std::vector<uint8_t>{'a', 'b', 'c'};
+
+    auto prehash = Prehash();
+    prehash.update(abc);
+    const auto digest = prehash.final();
+    auto sig = ph_key.signPrehashed(digest);
+    TEST_ASSERT_THROW(sig == ph_sig)
+    TEST_ASSERT_THROW(ph_pub_key.verifyPrehashed(digest, sig))
+
+    // Feeding the message in parts gives the same digest and final resets
+    prehash.update({abc.data(), 1});
+    prehash.update({abc.data() + 1, 2});
+    TEST_ASSERT_THROW(prehash.final() == digest)
+
+    // A moved-from object starts over with an empty message
+    prehash.update({abc.data(), 1});
+    auto moved = std::move(prehash);
+    prehash.update(abc);
+    TEST_ASSERT_THROW(prehash.final() == digest)
+
+    // A prehashed signature is not a pure Ed25519 signature of the message
+    TEST_ASSERT_THROW(
+        ph_pub_key.tryVerifySignature(abc, sig) == VerifyResult::Invalid
+    )
+
+    // RFC 8032 section 7.2, Ed25519ctx with context "foo"
+    constexpr auto ctx_pub = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0xdf, 0xc9, 0x42, 0x5e, 0x4f, 0x96, 0x8f, 0x7f, 0x0c, 0x29, 0xf0,
+        0x25, 0x9c, 0xf5, 0xf9, 0xae, 0xd6, 0x85, 0x1c, 0x2b, 0xb4, 0xad,
+        0x8b, 0xfb, 0x86, 0x0c, 0xfe, 0xe0, 0xab, 0x24, 0x82, 0x92};
+    constexpr auto ctx_msg = std::array<uint8_t, 16>{
+        0xf7, 0x26, 0x93, 0x6d, 0x19, 0xc8, 0x00, 0x49, 0x4e, 0x3f, 0xda,
+        0xff, 0x20, 0xb2, 0x76, 0xa8};
+    constexpr auto ctx_sig = std::array<uint8_t, ED25519_SIGNATURE_SIZE>{
+        0x55, 0xa4, 0xcc, 0x2f, 0x70, 0xa5, 0x4e, 0x04, 0x28, 0x8c, 0x5f,
+        0x4c, 0xd1, 0xe4, 0x5a, 0x7b, 0xb5, 0x20, 0xb3, 0x62, 0x92, 0x91,
+        0x18, 0x76, 0xca, 0xda, 0x73, 0x23, 0x19, 0x8d, 0xd8, 0x7a, 0x8b,
+        0x36, 0x95, 0x0b, 0x95, 0x13, 0x00, 0x22, 0x90, 0x7a, 0x7f, 0xb7,
+        0xc4, 0xe9, 0xb2, 0xd5, 0xf6, 0xcc, 0xa6, 0x85, 0xa5, 0x87, 0xb4,
+        0xb2, 0x1f, 0x4b, 0x88, 0x8e, 0x4e, 0x7e, 0xdb, 0x0d};
+
+    // The secret key of this vector sets the third highest scalar bit,
+    // which extend clears, so only the verification side is checked here.
+    const auto ctx_pub_key = PublicKey(ctx_pub);
+    const auto foo = std::vector<uint8_t>{'f', 'o', 'o'};
+    const auto bar = std::vector<uint8_t>{'b', 'a', 'r'};
+    TEST_ASSERT_THROW(ctx_pub_key.verifyWithContext(ctx_msg, ctx_sig, foo))
+
+    sig = ph_key.signWithContext(ctx_msg, foo);
+    TEST_ASSERT_THROW(ph_key.extend().signWithContext(ctx_msg, foo) == sig)
+    TEST_ASSERT_THROW(ph_pub_key.verifyWithContext(ctx_msg, sig, foo))
+
+    // The context is bound into the signature
+    TEST_ASSERT_THROW(!ph_pub_key.verifyWithContext(ctx_msg, sig, bar))
+    TEST_ASSERT_THROW(!ph_pub_key.verifySignature(ctx_msg, sig))
+
+    // Contexts are limited to 255 bytes and Ed25519ctx requires one
+    const auto long_ctx = std::vector<uint8_t>(256, 0x61);
+    for (const auto& ctx : {long_ctx, std::vector<uint8_t>{}})
+    {
+        auto threw = false;
+        try
+        {
+            (void)ph_key.signWithContext(ctx_msg, ctx);
+        }
+        catch (const std::invalid_argument&)
+        {
+            threw = true;
+        }
+        TEST_ASSERT_THROW(threw)
+    }
+}
+
 auto main() -> int
 {
     testBasic();
     testAdvanced();
+    testBatch();
+    testSegments();
+    testStreaming();
+    testPrehashAndContext();
     return 0;
 }
\ No newline at end of file
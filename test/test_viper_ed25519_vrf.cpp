@@ -3,10 +3,13 @@
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <optional>
 #include <span>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
+#include <viper25519/leader_schedule.hpp>
 #include <viper25519/vrf25519.hpp>
 
 #include "testing.hpp"
@@ -21,29 +24,32 @@ typedef struct TestData_
     const char hash[2 * 64 + 1];
 } TestData;
 
-// /// Test data taken from
-// /// https://datatracker.ietf.org/doc/html/draft-irtf-cfrg-vrf-13#appendix-A.4
-// /// which contains the seeds and expected values.
-// static const TestData test_data[] = {
-//     {
-//         "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
-//         "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
-//         "7d9c633ffeee27349264cf5c667579fc583b4bda63ab71d001f89c10003ab46f14adf9a3cd8b8412d9038531e865c341cafa73589b023d14311c331a9ad15ff2fb37831e00f0acaa6d73bc9997b06501",
-//         "9d574bf9b8302ec0fc1e21c3ec5368269527b87b462ce36dab2d14ccf80c53cccf6758f058c5b1c856b116388152bbe509ee3b9ecfe63d93c3b4346c1fbc6c54"
-//     },
-//     {
-//         "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
-//         "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
-//         "47b327393ff2dd81336f8a2ef10339112401253b3c714eeda879f12c509072ef055b48372bb82efbdce8e10c8cb9a2f9d60e93908f93df1623ad78a86a028d6bc064dbfc75a6a57379ef855dc6733801",
-//         "38561d6b77b71d30eb97a062168ae12b667ce5c28caccdf76bc88e093e4635987cd96814ce55b4689b3dd2947f80e59aac7b7675f8083865b46c89b2ce9cc735"
-//     },
-//     {
-//         "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
-//         "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
-//         "926e895d308f5e328e7aa159c06eddbe56d06846abf5d98c2512235eaa57fdce35b46edfc655bc828d44ad09d1150f31374e7ef73027e14760d42e77341fe05467bb286cc2c9d7fde29120a0b2320d04",
-//         "121b7f9b9aaaa29099fc04a94ba52784d44eac976dd1a3cca458733be5cd090a7b5fbd148444f17f8daf1fb55cb04b1ae85a626e30a54b4b0f8abf4a43314a58"
-//     }
-// };
+/// Test data taken from
+/// https://datatracker.ietf.org/doc/html/rfc9381#appendix-B.3
+/// (ECVRF-EDWARDS25519-SHA512-ELL2) with the same seeds and messages.
+static const TestData rfc9381_test_data[] = {
+    {"9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60",
+     "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a",
+     "7d9c633ffeee27349264cf5c667579fc583b4bda63ab71d001f89c10003ab46f14adf9a3c"
+     "d8b8412d9038531e865c341cafa73589b023d14311c331a9ad15ff2fb37831e00f0acaa6d"
+     "73bc9997b06501",
+     "9d574bf9b8302ec0fc1e21c3ec5368269527b87b462ce36dab2d14ccf80c53cccf6758f05"
+     "8c5b1c856b116388152bbe509ee3b9ecfe63d93c3b4346c1fbc6c54"},
+    {"4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb",
+     "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c",
+     "47b327393ff2dd81336f8a2ef10339112401253b3c714eeda879f12c509072ef055b48372"
+     "bb82efbdce8e10c8cb9a2f9d60e93908f93df1623ad78a86a028d6bc064dbfc75a6a57379"
+     "ef855dc6733801",
+     "38561d6b77b71d30eb97a062168ae12b667ce5c28caccdf76bc88e093e4635987cd96814c"
+     "e55b4689b3dd2947f80e59aac7b7675f8083865b46c89b2ce9cc735"},
+    {"c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7",
+     "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025",
+     "926e895d308f5e328e7aa159c06eddbe56d06846abf5d98c2512235eaa57fdce35b46edfc"
+     "655bc828d44ad09d1150f31374e7ef73027e14760d42e77341fe05467bb286cc2c9d7fde2"
+     "9120a0b2320d04",
+     "121b7f9b9aaaa29099fc04a94ba52784d44eac976dd1a3cca458733be5cd090a7b5fbd148"
+     "444f17f8daf1fb55cb04b1ae85a626e30a54b4b0f8abf4a43314a58"}
+};
 
 /// Test data taken from
 /// https://datatracker.ietf.org/doc/html/draft-irtf-cfrg-vrf-03#appendix-A.4
@@ -107,6 +113,22 @@ static auto hexToByteArray(std::string_view hex) -> std::array<uint8_t, Size>
     return byte_array;
 }
 
+/// Add the group order L to a little endian scalar below 2^253.
+static auto addGroupOrder(std::span<uint8_t, 32> s) -> void
+{
+    constexpr auto order = std::array<uint8_t, 32>{
+        0xed, 0xd3, 0xf5, 0x5c, 0x1a, 0x63, 0x12, 0x58, 0xd6, 0x9c, 0xf7,
+        0xa2, 0xde, 0xf9, 0xde, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10};
+    auto carry = 0u;
+    for (size_t i = 0; i < s.size(); ++i)
+    {
+        carry += static_cast<unsigned>(s[i]) + order[i];
+        s[i] = static_cast<uint8_t>(carry);
+        carry >>= 8;
+    }
+}
+
 auto testBasic() -> void
 {
     auto vrf_key =
@@ -141,11 +163,18 @@ auto testAdvanced() -> void
         // Check the proof hash.
         auto hash = vrf_skey.hash({messages[i], i});
         TEST_ASSERT_THROW(hash == hexToByteArray<64>(test_data[i].hash));
+        TEST_ASSERT_THROW(
+            vrf_pkey.verifyProofAndHash({messages[i], i}, proof) ==
+            std::optional(hash)
+        );
 
         // Verify the proof does not work when the proof is modified.
 
         proof[0] ^= 0x01;  // bad gamma
         TEST_ASSERT_THROW(!vrf_pkey.verifyProof({messages[i], i}, proof));
+        TEST_ASSERT_THROW(
+            !vrf_pkey.verifyProofAndHash({messages[i], i}, proof)
+        );
         proof[0] ^= 0x01;
 
         proof[32] ^= 0x01;  // bad c value
@@ -160,6 +189,23 @@ auto testAdvanced() -> void
         TEST_ASSERT_THROW(!vrf_pkey.verifyProof({messages[i], i}, proof));
         proof[79] ^= 0x80;
 
+        // Like libsodium, draft-03 reduces s so s + L is accepted, while
+        // RFC 9381 requires s < L.
+        auto unreduced = proof;
+        addGroupOrder(std::span(unreduced).last<32>());
+        TEST_ASSERT_THROW(vrf_pkey.verifyProof({messages[i], i}, unreduced));
+        TEST_ASSERT_THROW(
+            vrf_pkey.verifyProofAndHash({messages[i], i}, unreduced) ==
+            std::optional(hash)
+        );
+        auto rfc_proof = vrf_skey.constructProof(
+            {messages[i], i}, VRFSuite::Rfc9381
+        );
+        addGroupOrder(std::span(rfc_proof).last<32>());
+        TEST_ASSERT_THROW(!vrf_pkey.verifyProof(
+            {messages[i], i}, rfc_proof, VRFSuite::Rfc9381
+        ));
+
         if (i > 0)
         {
             // Verify should fail with truncated message.
@@ -169,9 +215,319 @@ auto testAdvanced() -> void
     }
 }
 
+auto testRfc9381() -> void
+{
+    constexpr auto suite = VRFSuite::Rfc9381;
+    for (size_t i = 0U; i < std::size(rfc9381_test_data); i++)
+    {
+        const auto& data = rfc9381_test_data[i];
+        const auto msg = std::span(messages[i], i);
+        auto vrf_skey = VRFSecretKey::fromSeed(hexToByteArray<32>(data.seed));
+        auto vrf_pkey = vrf_skey.publicKey();
+        TEST_ASSERT_THROW(vrf_pkey.bytes() == hexToByteArray<32>(data.pubk));
+
+        auto proof = vrf_skey.constructProof(msg, suite);
+        TEST_ASSERT_THROW(proof == hexToByteArray<80>(data.proof));
+        TEST_ASSERT_THROW(vrf_pkey.verifyProof(msg, proof, suite));
+        TEST_ASSERT_THROW(
+            VRFSecretKey::proofToHash(proof, suite) ==
+            hexToByteArray<64>(data.hash)
+        );
+        TEST_ASSERT_THROW(
+            vrf_skey.hash(msg, suite) == hexToByteArray<64>(data.hash)
+        );
+
+        // The suites are not interchangeable.
+        TEST_ASSERT_THROW(!vrf_pkey.verifyProof(msg, proof));
+        const auto draft03_proof = vrf_skey.constructProof(msg);
+        TEST_ASSERT_THROW(!vrf_pkey.verifyProof(msg, draft03_proof, suite));
+
+        TEST_ASSERT_THROW(
+            vrf_pkey.verifyProofAndHash(msg, proof, suite) ==
+            std::optional(hexToByteArray<64>(data.hash))
+        );
+
+        proof[32] ^= 0x01;  // bad c value
+        TEST_ASSERT_THROW(!vrf_pkey.verifyProof(msg, proof, suite));
+        TEST_ASSERT_THROW(!vrf_pkey.verifyProofAndHash(msg, proof, suite));
+        proof[32] ^= 0x01;
+
+        proof[79] ^= 0x80;  // s out of range
+        TEST_ASSERT_THROW(!vrf_pkey.verifyProof(msg, proof, suite));
+        proof[79] ^= 0x80;
+
+        // Wrong proof length
+        TEST_ASSERT_THROW(
+            !vrf_pkey.verifyProof(msg, std::span(proof).first<79>(), suite)
+        );
+    }
+}
+
+// Keys are derived with the RFC 8032 clamping whatever the value of the
+// third highest bit of the hashed seed. VRFSecretKey::generate only returns
+// seeds with that bit clear, so the seeds below cover the other case: the
+// SHA-512 of {2, 7, 0, ...}, {6, 7, 0, ...} and {9, 7, 0, ...} has bit 253
+// set.
+auto testGeneratedKeys() -> void
+{
+    const auto msg = std::vector<uint8_t>{'v', 'r', 'f'};
+    auto keys = std::vector<VRFSecretKey>();
+    for (const auto first : std::array<uint8_t, 3>{2, 6, 9})
+    {
+        auto seed = std::array<uint8_t, ED25519_VRF_SEED_SIZE>{first, 7};
+        keys.push_back(VRFSecretKey::fromSeed(seed));
+    }
+    for (size_t i = 0; i < 8; i++) keys.push_back(VRFSecretKey::generate());
+
+    for (auto& vrf_skey : keys)
+    {
+        TEST_ASSERT_THROW(vrf_skey.isValid());
+        const auto vrf_pkey = vrf_skey.publicKey();
+        for (const auto suite : {VRFSuite::IetfDraft03, VRFSuite::Rfc9381})
+        {
+            const auto proof = vrf_skey.constructProof(msg, suite);
+            TEST_ASSERT_THROW(vrf_pkey.verifyProof(msg, proof, suite));
+        }
+        const auto sig = vrf_skey.sign(msg);
+        TEST_ASSERT_THROW(vrf_pkey.verifySignature(msg, sig));
+    }
+}
+
+auto testBatchCompatible() -> void
+{
+    constexpr auto suite = VRFSuite::Rfc9381;
+    auto keys = std::vector<VRFPublicKey>();
+    auto msgs = std::vector<std::span<const uint8_t>>();
+    auto proofs =
+        std::vector<std::array<uint8_t, ED25519_VRF_BATCH_PROOF_SIZE>>();
+    for (size_t i = 0U; i < std::size(rfc9381_test_data); i++)
+    {
+        const auto& data = rfc9381_test_data[i];
+        const auto msg = std::span(messages[i], i);
+        auto vrf_skey = VRFSecretKey::fromSeed(hexToByteArray<32>(data.seed));
+        const auto vrf_pkey = vrf_skey.publicKey();
+
+        // Same Gamma and s as the RFC 9381 proof, so the same hash.
+        auto proof = vrf_skey.constructBatchCompatibleProof(msg);
+        const auto expected = hexToByteArray<80>(data.proof);
+        TEST_ASSERT_THROW(
+            std::equal(proof.begin(), proof.begin() + 32, expected.begin())
+        );
+        TEST_ASSERT_THROW(
+            std::equal(proof.begin() + 96, proof.end(), expected.begin() + 48)
+        );
+        TEST_ASSERT_THROW(vrf_pkey.verifyBatchCompatibleProof(msg, proof));
+        TEST_ASSERT_THROW(
+            VRFSecretKey::batchCompatibleProofToHash(proof) ==
+            vrf_skey.hash(msg, suite)
+        );
+
+        proof[40] ^= 0x01;  // bad U value
+        TEST_ASSERT_THROW(!vrf_pkey.verifyBatchCompatibleProof(msg, proof));
+        proof[40] ^= 0x01;
+
+        keys.push_back(vrf_pkey);
+        msgs.push_back(msg);
+        proofs.push_back(proof);
+    }
+
+    // Add a few generated keys with a longer message.
+    const auto msg = std::vector<uint8_t>(100, 0x5a);
+    for (size_t i = 0; i < 8; i++)
+    {
+        const auto vrf_skey = VRFSecretKey::generate();
+        keys.push_back(vrf_skey.publicKey());
+        msgs.push_back(msg);
+        proofs.push_back(vrf_skey.constructBatchCompatibleProof(msg));
+    }
+    TEST_ASSERT_THROW(VRFPublicKey::verifyProofBatch(keys, msgs, proofs));
+    TEST_ASSERT_THROW(VRFPublicKey::verifyProofBatch({}, {}, {}));
+
+    // A single bad proof fails the whole batch.
+    proofs[5][100] ^= 0x01;  // bad s value
+    TEST_ASSERT_THROW(!VRFPublicKey::verifyProofBatch(keys, msgs, proofs));
+    proofs[5][100] ^= 0x01;
+    std::swap(msgs[1], msgs[2]);
+    TEST_ASSERT_THROW(!VRFPublicKey::verifyProofBatch(keys, msgs, proofs));
+    std::swap(msgs[1], msgs[2]);
+
+    auto threw = false;
+    try
+    {
+        [[maybe_unused]] const auto ok = VRFPublicKey::verifyProofBatch(
+            keys, std::span(msgs).first(2), proofs
+        );
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT_THROW(threw);
+
+    // A public key with a component of order 8 shifts the U recomputed by
+    // the verifier by a torsion point. Both checks are cofactored and must
+    // agree on such a proof.
+    constexpr auto torsion = std::array<uint8_t, ED25519_KEY_SIZE>{
+        0x26, 0xe8, 0x95, 0x8f, 0xc2, 0xb2, 0x27, 0xb0, 0x45, 0xc3, 0xf4,
+        0x89, 0xf2, 0xef, 0x98, 0xf0, 0xd5, 0xdf, 0xac, 0x05, 0xd3, 0xc6,
+        0x33, 0x39, 0xb1, 0x38, 0x02, 0x88, 0x6d, 0x53, 0xfc, 0x05};
+    const auto seed = hexToByteArray<32>(rfc9381_test_data[0].seed);
+    const auto y = VRFSecretKey::fromSeed(seed).publicKey().bytes();
+    const auto mixed = PublicKey(y).pointAdd(PublicKey(torsion)).bytes();
+    auto skpk = std::array<uint8_t, ED25519_VRF_SECRET_KEY_SIZE>{};
+    std::copy(seed.begin(), seed.end(), skpk.begin());
+    std::copy(mixed.begin(), mixed.end(), skpk.begin() + 32);
+    const auto mixed_skey = VRFSecretKey(skpk);
+    const auto mixed_pkey = VRFPublicKey(mixed);
+    const auto mixed_proof = mixed_skey.constructBatchCompatibleProof(msg);
+    TEST_ASSERT_THROW(mixed_pkey.verifyBatchCompatibleProof(msg, mixed_proof));
+    const auto mixed_msgs = std::array{std::span<const uint8_t>(msg)};
+    TEST_ASSERT_THROW(VRFPublicKey::verifyProofBatch(
+        std::span(&mixed_pkey, 1), mixed_msgs, std::span(&mixed_proof, 1)
+    ));
+}
+
+// A prepared key produces the same proofs and hashes as the key it was
+// prepared from.
+auto testPreparedKey() -> void
+{
+    for (size_t i = 0U; i < std::size(test_data); i++)
+    {
+        const auto msg = std::span(messages[i], i);
+        auto vrf_skey =
+            VRFSecretKey::fromSeed(hexToByteArray<32>(test_data[i].seed));
+        const auto prepared = PreparedVRFSecretKey(vrf_skey);
+        TEST_ASSERT_THROW(
+            prepared.publicKey().bytes() == vrf_skey.publicKey().bytes()
+        );
+
+        for (const auto suite : {VRFSuite::IetfDraft03, VRFSuite::Rfc9381})
+        {
+            const auto proof = prepared.constructProof(msg, suite);
+            TEST_ASSERT_THROW(proof == vrf_skey.constructProof(msg, suite));
+            const auto [fused_proof, hash] =
+                prepared.constructProofAndHash(msg, suite);
+            TEST_ASSERT_THROW(fused_proof == proof);
+            TEST_ASSERT_THROW(hash == VRFSecretKey::proofToHash(proof, suite));
+            TEST_ASSERT_THROW(prepared.hash(msg, suite) == hash);
+            TEST_ASSERT_THROW(prepared.verifyProof(msg, proof, suite));
+            const auto other = suite == VRFSuite::Rfc9381
+                                   ? VRFSuite::IetfDraft03
+                                   : VRFSuite::Rfc9381;
+            TEST_ASSERT_THROW(!prepared.verifyProof(msg, proof, other));
+        }
+        TEST_ASSERT_THROW(
+            prepared.constructBatchCompatibleProof(msg) ==
+            vrf_skey.constructBatchCompatibleProof(msg)
+        );
+
+        // Hashing without proving gives the hashes of the proofs.
+        auto msgs = std::vector<std::span<const uint8_t>>();
+        for (size_t j = 0U; j < std::size(messages); j++)
+            msgs.push_back(std::span(messages[j], j));
+        for (const auto suite : {VRFSuite::IetfDraft03, VRFSuite::Rfc9381})
+        {
+            const auto hashes = prepared.hashBatch(msgs, suite);
+            TEST_ASSERT_THROW(hashes.size() == msgs.size());
+            for (size_t j = 0U; j < msgs.size(); j++)
+                TEST_ASSERT_THROW(hashes[j] == vrf_skey.hash(msgs[j], suite));
+        }
+        TEST_ASSERT_THROW(prepared.hashBatch({}).empty());
+    }
+
+    // A key whose public half does not match its seed is rejected.
+    auto bytes = std::array<uint8_t, ED25519_VRF_SECRET_KEY_SIZE>{};
+    std::copy_n(
+        VRFSecretKey::generate().bytes().begin(), bytes.size(), bytes.begin()
+    );
+    bytes[40] ^= 0x01;
+    auto threw = false;
+    try
+    {
+        [[maybe_unused]] const auto prepared =
+            PreparedVRFSecretKey(VRFSecretKey(bytes));
+    }
+    catch (const std::invalid_argument&)
+    {
+        threw = true;
+    }
+    TEST_ASSERT_THROW(threw);
+}
+
+auto testLeaderSchedule() -> void
+{
+    auto nonce = std::array<uint8_t, 32>{};
+    for (size_t i = 0; i < nonce.size(); i++)
+        nonce[i] = static_cast<uint8_t>(i);
+    TEST_ASSERT_THROW(
+        praosSlotInput(0, nonce) ==
+        hexToByteArray<32>(
+            "cf9e767e2c7a02130808195fc91f38b2a7d91f291077b0e54ed50cf6a717038c"
+        )
+    );
+    TEST_ASSERT_THROW(
+        praosSlotInput(123456789, nonce) ==
+        hexToByteArray<32>(
+            "d92fba7deddf84b4ee664090838bb520343e8fb89721c51bd37537274bb1256d"
+        )
+    );
+
+    const auto vrf_skey =
+        VRFSecretKey::fromSeed(hexToByteArray<32>(test_data[1].seed));
+    const auto prepared = PreparedVRFSecretKey(vrf_skey);
+    const auto input = [&](uint64_t slot)
+    {
+        const auto bytes = praosSlotInput(slot, nonce);
+        return std::vector<uint8_t>(bytes.begin(), bytes.end());
+    };
+    // Lead roughly one slot in four.
+    const auto is_leader = [](uint64_t, std::span<const uint8_t, 64> hash)
+    { return hash[0] < 64; };
+
+    auto pool = ThreadPool(4);
+    auto scheduler = LeaderScheduler(pool);
+    auto options = LeaderScheduleOptions{};
+    options.firstSlot = 1000;
+    options.slotCount = 203;  // not a multiple of the chunk size
+    options.chunkSize = 16;
+    const auto schedule =
+        scheduler.compute(prepared, input, is_leader, options);
+
+    // Compare with proving every slot in turn.
+    auto expected = std::vector<uint64_t>();
+    for (uint64_t slot = 1000; slot < 1203; slot++)
+    {
+        const auto hash =
+            VRFSecretKey::proofToHash(prepared.constructProof(input(slot)));
+        if (is_leader(slot, hash)) expected.push_back(slot);
+    }
+    TEST_ASSERT_THROW(!expected.empty());
+    TEST_ASSERT_THROW(schedule.size() == expected.size());
+    const auto vrf_pkey = vrf_skey.publicKey();
+    for (size_t i = 0; i < schedule.size(); i++)
+    {
+        const auto& leader = schedule[i];
+        TEST_ASSERT_THROW(leader.slot == expected[i]);
+        TEST_ASSERT_THROW(
+            vrf_pkey.verifyProofAndHash(input(leader.slot), leader.proof) ==
+            std::optional(leader.hash)
+        );
+    }
+
+    options.slotCount = 0;
+    TEST_ASSERT_THROW(
+        scheduler.compute(prepared, input, is_leader, options).empty()
+    );
+}
+
 auto main() -> int
 {
     testBasic();
     testAdvanced();
+    testRfc9381();
+    testGeneratedKeys();
+    testBatchCompatible();
+    testPreparedKey();
+    testLeaderSchedule();
     return 0;
 }
\ No newline at end of file
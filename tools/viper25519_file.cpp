@@ -0,0 +1,353 @@
+// Copyright (c) 2024 Viper Science LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+// Command line tool for signing files and verifying manifests of file
+// signatures. Files are memory mapped so that signing reads the data twice
+// (once for the nonce and once for the challenge hash) without copying it to
+// the heap.
+//
+//   viper25519_file keygen
+//   viper25519_file sign <key file> <file>...
+//   viper25519_file verify [--threads N] [--mode legacy|rfc8032|zip215]
+//                          <manifest>
+//
+// sign prints one manifest line per file:
+//
+//   <public key hex> <signature hex> <path>
+//
+// and verify checks every line of such a manifest in parallel.
+
+// Standard Library Headers
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// System Headers
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Public Viper25519 Headers
+#include <viper25519/ed25519.hpp>
+#include <viper25519/thread_pool.hpp>
+
+using namespace ed25519;
+
+namespace
+{
+
+/// Read-only memory mapping of a whole file.
+class MappedFile
+{
+  private:
+    void* addr_ = nullptr;
+    size_t size_ = 0;
+
+  public:
+    explicit MappedFile(const std::string& path)
+    {
+        const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            throw std::runtime_error(path + ": " + std::strerror(errno));
+
+        struct stat st = {};
+        if (::fstat(fd, &st) != 0)
+        {
+            const auto err = errno;
+            ::close(fd);
+            throw std::runtime_error(path + ": " + std::strerror(err));
+        }
+        this->size_ = static_cast<size_t>(st.st_size);
+
+        // An empty file cannot be mapped but signs as an empty message.
+        if (this->size_ > 0)
+        {
+            this->addr_ =
+                ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (this->addr_ == MAP_FAILED)
+            {
+                const auto err = errno;
+                ::close(fd);
+                this->addr_ = nullptr;
+                throw std::runtime_error(path + ": " + std::strerror(err));
+            }
+
+            // Both hash passes read the file front to back. The advice is
+            // only a hint so a failure is not an error.
+            (void)::madvise(this->addr_, this->size_, MADV_SEQUENTIAL);
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        ::close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if (this->addr_ != nullptr) ::munmap(this->addr_, this->size_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    [[nodiscard]] auto bytes() const -> std::span<const uint8_t>
+    {
+        return {static_cast<const uint8_t*>(this->addr_), this->size_};
+    }
+
+};  // MappedFile
+
+/// One line of a signature manifest.
+struct ManifestEntry
+{
+    std::string path;
+    std::array<uint8_t, ED25519_KEY_SIZE> pub{};
+    std::array<uint8_t, ED25519_SIGNATURE_SIZE> sig{};
+};
+
+auto to_hex(std::span<const uint8_t> bytes) -> std::string
+{
+    static constexpr auto digits = std::string_view{"0123456789abcdef"};
+    auto hex = std::string();
+    hex.reserve(bytes.size() * 2);
+    for (const auto b : bytes)
+    {
+        hex.push_back(digits[b >> 4]);
+        hex.push_back(digits[b & 0x0f]);
+    }
+    return hex;
+}  // to_hex
+
+auto from_hex(std::string_view hex, std::span<uint8_t> out) -> bool
+{
+    auto nibble = [](char c) -> int
+    {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+
+    if (hex.size() != out.size() * 2) return false;
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+        const auto hi = nibble(hex[2 * i]);
+        const auto lo = nibble(hex[2 * i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}  // from_hex
+
+auto read_manifest(const std::string& path) -> std::vector<ManifestEntry>
+{
+    auto file = std::ifstream(path);
+    if (!file) throw std::runtime_error(path + ": cannot open manifest");
+
+    auto entries = std::vector<ManifestEntry>();
+    auto line = std::string();
+    auto line_no = size_t{0};
+    while (std::getline(file, line))
+    {
+        ++line_no;
+        if (line.empty() || line.front() == '#') continue;
+
+        // <public key hex> <signature hex> <path>, the path may hold spaces
+        constexpr auto pub_len = 2 * ED25519_KEY_SIZE;
+        constexpr auto sig_len = 2 * ED25519_SIGNATURE_SIZE;
+        constexpr auto path_pos = pub_len + 1 + sig_len + 1;
+        auto entry = ManifestEntry();
+        const auto view = std::string_view(line);
+        if (view.size() <= path_pos || view[pub_len] != ' ' ||
+            view[path_pos - 1] != ' ' ||
+            !from_hex(view.substr(0, pub_len), entry.pub) ||
+            !from_hex(view.substr(pub_len + 1, sig_len), entry.sig))
+        {
+            throw std::runtime_error(
+                path + ":" + std::to_string(line_no) + ": malformed entry"
+            );
+        }
+        entry.path = std::string(view.substr(path_pos));
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}  // read_manifest
+
+auto usage() -> int
+{
+    std::cerr
+        << "usage: viper25519_file keygen\n"
+        << "       viper25519_file sign <key file> <file>...\n"
+        << "       viper25519_file verify [--threads N] "
+           "[--mode legacy|rfc8032|zip215] <manifest>\n";
+    return 2;
+}  // usage
+
+auto cmd_keygen() -> int
+{
+    const auto key = PrivateKey::generate();
+    std::cout << to_hex(key.bytes()) << '\n';
+    return 0;
+}  // cmd_keygen
+
+auto cmd_sign(const std::vector<std::string>& args) -> int
+{
+    if (args.size() < 2) return usage();
+
+    auto key_hex = std::string();
+    {
+        auto key_file = std::ifstream(args[0]);
+        if (!key_file || !(key_file >> key_hex))
+            throw std::runtime_error(args[0] + ": cannot read key");
+    }
+    auto key_bytes = std::array<uint8_t, ED25519_KEY_SIZE>{};
+    const auto parsed = from_hex(key_hex, key_bytes);
+    std::fill(key_hex.begin(), key_hex.end(), '\0');
+    if (!parsed) throw std::runtime_error(args[0] + ": malformed key");
+
+    // Extend the key once rather than once per file.
+    const auto key = PrivateKey(key_bytes).extend();
+    std::fill(key_bytes.begin(), key_bytes.end(), uint8_t{0});
+    const auto pub_hex = to_hex(key.publicKey().bytes());
+
+    for (size_t i = 1; i < args.size(); ++i)
+    {
+        const auto file = MappedFile(args[i]);
+        const auto sig = key.sign(file.bytes());
+        std::cout << pub_hex << ' ' << to_hex(sig) << ' ' << args[i] << '\n';
+    }
+    return 0;
+}  // cmd_sign
+
+auto cmd_verify(const std::vector<std::string>& args) -> int
+{
+    auto threads = size_t{0};
+    auto mode = VerifyMode::Legacy;
+    auto manifest = std::optional<std::string>();
+    for (size_t i = 0; i < args.size(); ++i)
+    {
+        if (args[i] == "--threads" && i + 1 < args.size())
+        {
+            threads = std::stoul(args[++i]);
+        }
+        else if (args[i] == "--mode" && i + 1 < args.size())
+        {
+            const auto& name = args[++i];
+            if (name == "legacy")
+                mode = VerifyMode::Legacy;
+            else if (name == "rfc8032")
+                mode = VerifyMode::Rfc8032;
+            else if (name == "zip215")
+                mode = VerifyMode::Zip215;
+            else
+                return usage();
+        }
+        else if (!manifest)
+        {
+            manifest = args[i];
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    if (!manifest) return usage();
+
+    const auto entries = read_manifest(*manifest);
+    auto errors = std::vector<std::string>(entries.size());
+    auto bytes = std::atomic<uint64_t>{0};
+
+    const auto start = std::chrono::steady_clock::now();
+    auto pool = ThreadPool(threads);
+    pool.parallelFor(
+        entries.size(),
+        [&](size_t i)
+        {
+            const auto& entry = entries[i];
+            try
+            {
+                const auto file = MappedFile(entry.path);
+                const auto result = PublicKey(entry.pub).tryVerifySignature(
+                    file.bytes(), entry.sig, mode
+                );
+                bytes.fetch_add(file.bytes().size(), std::memory_order_relaxed);
+                if (result == VerifyResult::Invalid)
+                    errors[i] = "bad signature";
+                else if (result == VerifyResult::MalformedSignature)
+                    errors[i] = "malformed signature";
+                else if (result == VerifyResult::MalformedPublicKey)
+                    errors[i] = "malformed public key";
+            }
+            catch (const std::exception& e)
+            {
+                errors[i] = e.what();
+            }
+        }
+    );
+    const auto elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start
+    );
+
+    auto failed = size_t{0};
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+        if (errors[i].empty()) continue;
+        ++failed;
+        std::cout << "FAILED " << entries[i].path << ": " << errors[i] << '\n';
+    }
+
+    const auto mib = static_cast<double>(bytes.load()) / (1024.0 * 1024.0);
+    std::cerr << entries.size() - failed << " of " << entries.size()
+              << " signatures valid, " << mib << " MiB in "
+              << elapsed.count() << " s on " << pool.size() << " threads\n";
+    return failed == 0 ? 0 : 1;
+}  // cmd_verify
+
+}  // namespace
+
+auto main(int argc, char* argv[]) -> int
+{
+    if (argc < 2) return usage();
+    const auto cmd = std::string_view(argv[1]);
+    const auto args = std::vector<std::string>(argv + 2, argv + argc);
+
+    try
+    {
+        if (cmd == "keygen" && args.empty()) return cmd_keygen();
+        if (cmd == "sign") return cmd_sign(args);
+        if (cmd == "verify") return cmd_verify(args);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "viper25519_file: " << e.what() << '\n';
+        return 1;
+    }
+    return usage();
+}